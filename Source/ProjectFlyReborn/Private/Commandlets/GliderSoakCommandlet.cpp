@@ -0,0 +1,371 @@
+#include "ProjectFlyReborn/Public/Commandlets/GliderSoakCommandlet.h"
+#include "ProjectFlyReborn/Public/Pawn/GliderPawn.h"
+#include "ProjectFlyReborn/Public/Flight/FlightAvoidanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGliderSoak, Log, All);
+
+namespace GliderSoak
+{
+	// Distance between spawned gliders
+	constexpr float SpawnSpacing = 3000.0f;
+	constexpr int32 SpawnRowLength = 40;
+	constexpr float SpawnHeight = 30000.0f;
+
+	// Scripted targets circle around the flight center
+	constexpr float TargetOrbitRadius = 60000.0f;
+	constexpr float TargetOrbitSpeed = 0.1f;
+	constexpr float TargetUpdateInterval = 1.0f;
+
+	constexpr float FixedDeltaTime = 1.0f / 60.0f;
+}
+
+void FGliderSoakMarkerTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (OutSeconds)
+	{
+		*OutSeconds = FPlatformTime::Seconds();
+	}
+}
+
+FString FGliderSoakMarkerTickFunction::DiagnosticMessage()
+{
+	return TEXT("FGliderSoakMarkerTickFunction");
+}
+
+UGliderSoakCommandlet::UGliderSoakCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGliderSoakCommandlet::Main(const FString& Params)
+{
+	FString MapName = TEXT("/Game/Maps/TestLevel");
+	FParse::Value(*Params, TEXT("Map="), MapName);
+
+	FString StepsParam = TEXT("10,100,1000,5000");
+	FParse::Value(*Params, TEXT("Steps="), StepsParam, false);
+
+	FString GliderClassName = TEXT("/Game/Pawn/BP_GliderPawn.BP_GliderPawn_C");
+	FParse::Value(*Params, TEXT("Glider="), GliderClassName);
+
+	int32 WarmupFrames = 60;
+	FParse::Value(*Params, TEXT("WarmupFrames="), WarmupFrames);
+	WarmupFrames = FMath::Max(0, WarmupFrames);
+
+	int32 MeasureFrames = 300;
+	FParse::Value(*Params, TEXT("MeasureFrames="), MeasureFrames);
+	MeasureFrames = FMath::Max(1, MeasureFrames);
+
+	FString OutputPath = FPaths::ProfilingDir() / TEXT("GliderSoak") / FString::Printf(TEXT("GliderScaling-%s.csv"), *FDateTime::Now().ToString());
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	TArray<FString> StepStrings;
+	StepsParam.ParseIntoArray(StepStrings, TEXT(","));
+
+	TArray<int32> Steps;
+	for (const FString& StepString : StepStrings)
+	{
+		const int32 Step = FCString::Atoi(*StepString);
+		if (Step > 0)
+		{
+			Steps.Add(Step);
+		}
+	}
+	Steps.Sort();
+
+	if (Steps.Num() == 0)
+	{
+		UE_LOG(LogGliderSoak, Error, TEXT("No valid glider counts in -Steps=%s"), *StepsParam);
+		return 1;
+	}
+
+	TSubclassOf<AGliderPawn> GliderClass = LoadClass<AGliderPawn>(nullptr, *GliderClassName);
+	if (!GliderClass)
+	{
+		UE_LOG(LogGliderSoak, Warning, TEXT("Failed to load %s, falling back to AGliderPawn"), *GliderClassName);
+		GliderClass = AGliderPawn::StaticClass();
+	}
+
+	// Per glider debug lines would dominate game thread time at high glider counts
+	if (IConsoleVariable* DebugDrawVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("fly.Glider.DebugDraw")))
+	{
+		DebugDrawVariable->Set(0, ECVF_SetByCommandline);
+	}
+
+	UWorld* World = CreateGameWorld(MapName);
+	if (!World)
+	{
+		UE_LOG(LogGliderSoak, Error, TEXT("Failed to load map %s"), *MapName);
+		return 1;
+	}
+
+	const UFlightAvoidanceSubsystem* Avoidance = World->GetSubsystem<UFlightAvoidanceSubsystem>();
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	const uint64 BaselineMemory = FPlatformMemory::GetStats().UsedPhysical;
+
+	TArray<FStepResult> Results;
+	float FlightTime = 0.0f;
+	float TimeSinceTargetUpdate = 0.0f;
+
+	for (const int32 Step : Steps)
+	{
+		SpawnGliders(World, GliderClass, Step - Gliders.Num());
+		UpdateFlyTargets(FlightTime);
+
+		// Gliders register with avoidance in BeginPlay, missing registrations mean we would measure a pawn that never started playing
+		if (!Avoidance || Avoidance->GetAircraftCount() != Gliders.Num())
+		{
+			UE_LOG(LogGliderSoak, Error, TEXT("BeginPlay did not reach spawned gliders (%d of %d registered for avoidance)"),
+				Avoidance ? Avoidance->GetAircraftCount() : 0, Gliders.Num());
+
+			DestroyGameWorld(World);
+			return 1;
+		}
+
+		TArray<double> GameThreadFrames;
+		double PhysicsTotalMs = 0.0;
+
+		for (int32 Frame = 0; Frame < WarmupFrames + MeasureFrames; ++Frame)
+		{
+			FlightTime += GliderSoak::FixedDeltaTime;
+			TimeSinceTargetUpdate += GliderSoak::FixedDeltaTime;
+
+			if (TimeSinceTargetUpdate >= GliderSoak::TargetUpdateInterval)
+			{
+				TimeSinceTargetUpdate = 0.0f;
+				UpdateFlyTargets(FlightTime);
+			}
+
+			double GameThreadMs, PhysicsMs;
+			TickWorld(World, GliderSoak::FixedDeltaTime, GameThreadMs, PhysicsMs);
+
+			if (Frame >= WarmupFrames)
+			{
+				GameThreadFrames.Add(GameThreadMs);
+				PhysicsTotalMs += PhysicsMs;
+			}
+		}
+
+		FStepResult& Result = Results.AddDefaulted_GetRef();
+		Result.AircraftCount = Gliders.Num();
+
+		double GameThreadTotalMs = 0.0;
+		for (const double FrameMs : GameThreadFrames)
+		{
+			GameThreadTotalMs += FrameMs;
+		}
+		GameThreadFrames.Sort();
+
+		// Statistics come from the collected frames, not from the requested count
+		const int32 MeasuredFrames = FMath::Max(1, GameThreadFrames.Num());
+
+		Result.GameThreadMs = GameThreadTotalMs / MeasuredFrames;
+		Result.GameThreadP95Ms = GameThreadFrames.Num() > 0 ? GameThreadFrames[FMath::Clamp(FMath::CeilToInt(0.95f * MeasuredFrames) - 1, 0, MeasuredFrames - 1)] : 0.0;
+		Result.PhysicsMs = PhysicsTotalMs / MeasuredFrames;
+
+		const double GarbageCollectionStart = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		Result.GarbageCollectionMs = (FPlatformTime::Seconds() - GarbageCollectionStart) * 1000.0;
+
+		const double UsedMemory = (double)FPlatformMemory::GetStats().UsedPhysical - (double)BaselineMemory;
+		Result.MemoryMB = UsedMemory / (1024.0 * 1024.0);
+		Result.MemoryPerAircraftKB = UsedMemory / 1024.0 / FMath::Max(1, Result.AircraftCount);
+
+		UE_LOG(LogGliderSoak, Display, TEXT("%5d gliders: game thread %.2f ms (p95 %.2f), physics %.2f ms, memory %.1f MB (%.1f KB per glider), GC %.2f ms"),
+			Result.AircraftCount, Result.GameThreadMs, Result.GameThreadP95Ms, Result.PhysicsMs,
+			Result.MemoryMB, Result.MemoryPerAircraftKB, Result.GarbageCollectionMs);
+	}
+
+	DestroyGameWorld(World);
+
+	if (!WriteCsv(OutputPath, Results))
+	{
+		UE_LOG(LogGliderSoak, Error, TEXT("Failed to write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogGliderSoak, Display, TEXT("Scaling curve written to %s"), *OutputPath);
+	return 0;
+}
+
+UWorld* UGliderSoakCommandlet::CreateGameWorld(const FString& MapName)
+{
+	UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Game;
+
+	GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.OwningGameInstance = GameInstance;
+	WorldContext.SetCurrentWorld(World);
+	World->SetGameInstance(GameInstance);
+
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true)
+			.ShouldSimulatePhysics(true));
+	}
+
+	World->UpdateWorldComponents(true, false);
+
+	GameInstance->Init();
+
+	// Game mode routes BeginPlay to actors, so it has to exist before the world begins play
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	// Bracket the physics step of every frame
+	PhysicsStartTickFunction.OutSeconds = &PhysicsStartSeconds;
+	PhysicsStartTickFunction.bCanEverTick = true;
+	PhysicsStartTickFunction.TickGroup = TG_StartPhysics;
+	PhysicsStartTickFunction.RegisterTickFunction(World->PersistentLevel);
+	World->StartPhysicsTickFunction.AddPrerequisite(this, PhysicsStartTickFunction);
+
+	PhysicsEndTickFunction.OutSeconds = &PhysicsEndSeconds;
+	PhysicsEndTickFunction.bCanEverTick = true;
+	PhysicsEndTickFunction.TickGroup = TG_EndPhysics;
+	PhysicsEndTickFunction.RegisterTickFunction(World->PersistentLevel);
+	PhysicsEndTickFunction.AddPrerequisite(World, World->EndPhysicsTickFunction);
+
+	// Fly around the player start if there is one
+	if (AActor* PlayerStart = World->GetAuthGameMode() ? World->GetAuthGameMode()->FindPlayerStart(nullptr) : nullptr)
+	{
+		FlightCenter = PlayerStart->GetActorLocation();
+	}
+
+	return World;
+}
+
+void UGliderSoakCommandlet::DestroyGameWorld(UWorld* World)
+{
+	World->StartPhysicsTickFunction.RemovePrerequisite(this, PhysicsStartTickFunction);
+	PhysicsStartTickFunction.UnRegisterTickFunction();
+	PhysicsEndTickFunction.UnRegisterTickFunction();
+
+	Gliders.Empty();
+
+	World->BeginTearingDown();
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		It->RouteEndPlay(EEndPlayReason::Quit);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	if (GameInstance)
+	{
+		GameInstance->Shutdown();
+		GameInstance->RemoveFromRoot();
+		GameInstance = nullptr;
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+}
+
+void UGliderSoakCommandlet::SpawnGliders(UWorld* World, TSubclassOf<AGliderPawn> GliderClass, int32 Count)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		// Fill layers of a square grid above the flight center
+		const int32 GliderIndex = Gliders.Num();
+		const int32 LayerSize = GliderSoak::SpawnRowLength * GliderSoak::SpawnRowLength;
+
+		const FVector Offset(
+			(GliderIndex % GliderSoak::SpawnRowLength - GliderSoak::SpawnRowLength / 2) * GliderSoak::SpawnSpacing,
+			(GliderIndex / GliderSoak::SpawnRowLength % GliderSoak::SpawnRowLength - GliderSoak::SpawnRowLength / 2) * GliderSoak::SpawnSpacing,
+			GliderSoak::SpawnHeight + GliderIndex / LayerSize * GliderSoak::SpawnSpacing);
+
+		const FRotator Rotation(0.0f, GliderIndex * 137.5f, 0.0f);
+
+		if (AGliderPawn* Glider = World->SpawnActor<AGliderPawn>(GliderClass, FlightCenter + Offset, Rotation, SpawnParameters))
+		{
+			Gliders.Add(Glider);
+		}
+	}
+}
+
+void UGliderSoakCommandlet::UpdateFlyTargets(float Time)
+{
+	for (int32 Index = 0; Index < Gliders.Num(); ++Index)
+	{
+		// Spread gliders over the orbit and over a few altitude layers
+		const float Angle = Time * GliderSoak::TargetOrbitSpeed + Index * 2.399963f;
+		const FVector Target = FlightCenter + FVector(
+			FMath::Cos(Angle) * GliderSoak::TargetOrbitRadius,
+			FMath::Sin(Angle) * GliderSoak::TargetOrbitRadius,
+			GliderSoak::SpawnHeight + (Index % 8) * GliderSoak::SpawnSpacing);
+
+		Gliders[Index]->SetDesiredDirection(Target);
+	}
+}
+
+void UGliderSoakCommandlet::TickWorld(UWorld* World, float DeltaTime, double& OutGameThreadMs, double& OutPhysicsMs)
+{
+	FApp::SetDeltaTime(DeltaTime);
+	FApp::SetCurrentTime(FApp::GetCurrentTime() + DeltaTime);
+
+	PhysicsStartSeconds = 0.0;
+	PhysicsEndSeconds = 0.0;
+
+	const double TickStart = FPlatformTime::Seconds();
+	World->Tick(LEVELTICK_All, DeltaTime);
+	OutGameThreadMs = (FPlatformTime::Seconds() - TickStart) * 1000.0;
+
+	OutPhysicsMs = PhysicsEndSeconds > PhysicsStartSeconds && PhysicsStartSeconds > 0.0
+		? (PhysicsEndSeconds - PhysicsStartSeconds) * 1000.0
+		: 0.0;
+
+	FTSTicker::GetCoreTicker().Tick(DeltaTime);
+	FlushRenderingCommands();
+
+	++GFrameCounter;
+}
+
+bool UGliderSoakCommandlet::WriteCsv(const FString& FilePath, const TArray<FStepResult>& Results) const
+{
+	FString Csv = TEXT("Aircraft,GameThreadMs,GameThreadP95Ms,PhysicsMs,MemoryMB,MemoryPerAircraftKB,GCMs\n");
+
+	for (const FStepResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%d,%.3f,%.3f,%.3f,%.2f,%.2f,%.3f\n"),
+			Result.AircraftCount, Result.GameThreadMs, Result.GameThreadP95Ms, Result.PhysicsMs,
+			Result.MemoryMB, Result.MemoryPerAircraftKB, Result.GarbageCollectionMs);
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
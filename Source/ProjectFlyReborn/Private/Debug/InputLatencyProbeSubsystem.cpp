@@ -0,0 +1,339 @@
+#include "ProjectFlyReborn/Public/Debug/InputLatencyProbeSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "RenderingThread.h"
+#include "Rendering/SlateRenderer.h"
+#include "RHIResources.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogInputLatency, Log, All);
+
+static TAutoConsoleVariable<int32> CVarLatencyProbe(
+	TEXT("fly.LatencyProbe"),
+	0,
+	TEXT("Measures mouse aim latency from input event to torque, physics and presented frame. 0 - off, 1 - on."));
+
+static TAutoConsoleVariable<float> CVarLatencyProbeReportInterval(
+	TEXT("fly.LatencyProbe.ReportInterval"),
+	2.0f,
+	TEXT("How often (seconds) latency percentiles are written to log and screen."));
+
+struct UInputLatencyProbeSubsystem::FRenderState
+{
+	// Render thread only, waiting for the next present
+	TArray<FLatencySample> AwaitingPresent;
+
+	FCriticalSection CompletedLock;
+	TArray<FLatencySample> Completed;
+
+	void OnBackBufferReadyToPresent(SWindow& Window, const FTexture2DRHIRef& BackBuffer)
+	{
+		PresentPending(FPlatformTime::Cycles64());
+	}
+
+	void PresentPending(uint64 PresentCycles)
+	{
+		if (AwaitingPresent.Num() == 0)
+		{
+			return;
+		}
+
+		for (FLatencySample& Sample : AwaitingPresent)
+		{
+			Sample.PresentCycles = PresentCycles;
+		}
+
+		FScopeLock Lock(&CompletedLock);
+		Completed.Append(MoveTemp(AwaitingPresent));
+		AwaitingPresent.Reset();
+	}
+};
+
+void FLatencyProbePhysicsTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Probe)
+	{
+		Probe->MarkPhysicsDone();
+	}
+}
+
+FString FLatencyProbePhysicsTickFunction::DiagnosticMessage()
+{
+	return TEXT("FLatencyProbePhysicsTickFunction");
+}
+
+void FLatencyHistogram::Add(float Milliseconds)
+{
+	if (Samples.Num() < MaxSamples)
+	{
+		Samples.Add(Milliseconds);
+	}
+	else
+	{
+		Samples[NextSample] = Milliseconds;
+	}
+	NextSample = (NextSample + 1) % MaxSamples;
+}
+
+void FLatencyHistogram::Reset()
+{
+	Samples.Reset();
+	NextSample = 0;
+}
+
+float FLatencyHistogram::GetPercentile(float Percentile) const
+{
+	if (Samples.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	TArray<float> Sorted = Samples;
+	Sorted.Sort();
+
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+	return Sorted[Index];
+}
+
+FString FLatencyHistogram::ToString() const
+{
+	// Buckets are built from the rolling window, so they describe the same samples as the percentiles
+	// Bucket 0 is below 1ms, bucket N covers [2^(N-1)..2^N) ms, last bucket is open ended
+	int32 Buckets[BucketCount] = {};
+	for (const float Milliseconds : Samples)
+	{
+		const int32 Bucket = Milliseconds < 1.0f ? 0 : FMath::Min(FMath::FloorLog2((uint32)Milliseconds) + 1, BucketCount - 1);
+		++Buckets[Bucket];
+	}
+
+	FString Result;
+
+	for (int32 Bucket = 0; Bucket < BucketCount; ++Bucket)
+	{
+		const int32 Lower = Bucket == 0 ? 0 : 1 << (Bucket - 1);
+
+		if (Bucket == BucketCount - 1)
+		{
+			Result += FString::Printf(TEXT("[%d+ ms: %d]"), Lower, Buckets[Bucket]);
+		}
+		else
+		{
+			Result += FString::Printf(TEXT("[%d-%d ms: %d] "), Lower, 1 << Bucket, Buckets[Bucket]);
+		}
+	}
+
+	return Result;
+}
+
+void UInputLatencyProbeSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	RenderState = MakeShared<FRenderState, ESPMode::ThreadSafe>();
+
+	// Present of the back buffer is the last point we can observe, without slate renderer (-nullrhi)
+	// samples are completed when the render thread picks them up
+	if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		PresentHandle = FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().AddThreadSafeSP(
+			RenderState.ToSharedRef(), &FRenderState::OnBackBufferReadyToPresent);
+		bHasPresentCallback = true;
+	}
+
+	PhysicsTickFunction.Probe = this;
+	PhysicsTickFunction.bCanEverTick = true;
+	PhysicsTickFunction.TickGroup = TG_PostPhysics;
+	PhysicsTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UInputLatencyProbeSubsystem::OnWorldPostActorTick);
+}
+
+void UInputLatencyProbeSubsystem::Deinitialize()
+{
+	if (PhysicsTickFunction.IsTickFunctionRegistered())
+	{
+		PhysicsTickFunction.UnRegisterTickFunction();
+	}
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	if (bHasPresentCallback && FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().Remove(PresentHandle);
+	}
+	bHasPresentCallback = false;
+
+	RenderState.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UInputLatencyProbeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInputLatencyProbeSubsystem, STATGROUP_Tickables);
+}
+
+bool UInputLatencyProbeSubsystem::IsEnabled()
+{
+	return CVarLatencyProbe.GetValueOnGameThread() != 0;
+}
+
+void UInputLatencyProbeSubsystem::MarkInput()
+{
+	if (PendingInputCycles == 0 && IsEnabled())
+	{
+		PendingInputCycles = FPlatformTime::Cycles64();
+	}
+}
+
+void UInputLatencyProbeSubsystem::MarkInputApplied()
+{
+	if (PendingInputCycles == 0)
+	{
+		return;
+	}
+
+	FLatencySample& Sample = AwaitingPhysics.AddDefaulted_GetRef();
+	Sample.InputCycles = PendingInputCycles;
+	Sample.AppliedCycles = FPlatformTime::Cycles64();
+
+	PendingInputCycles = 0;
+}
+
+void UInputLatencyProbeSubsystem::MarkPhysicsDone()
+{
+	if (AwaitingPhysics.Num() == 0)
+	{
+		return;
+	}
+
+	const uint64 PhysicsCycles = FPlatformTime::Cycles64();
+	for (FLatencySample& Sample : AwaitingPhysics)
+	{
+		Sample.PhysicsCycles = PhysicsCycles;
+	}
+
+	AwaitingFrame.Append(MoveTemp(AwaitingPhysics));
+	AwaitingPhysics.Reset();
+}
+
+void UInputLatencyProbeSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaTime)
+{
+	if (InWorld != GetWorld() || AwaitingFrame.Num() == 0 || !RenderState.IsValid())
+	{
+		return;
+	}
+
+	// Viewports are drawn after actor tick, so this command is executed right before rendering of the frame carrying the input
+	ENQUEUE_RENDER_COMMAND(LatencyProbeFrame)(
+		[State = RenderState, Samples = MoveTemp(AwaitingFrame), bWaitForPresent = bHasPresentCallback](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			State->AwaitingPresent.Append(MoveTemp(Samples));
+
+			if (!bWaitForPresent)
+			{
+				State->PresentPending(FPlatformTime::Cycles64());
+			}
+		});
+
+	AwaitingFrame.Reset();
+}
+
+void UInputLatencyProbeSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsEnabled())
+	{
+		// Start next probe session from clean histograms
+		if (FrameTime.Num() > 0)
+		{
+			InputToApply.Reset();
+			ApplyToPhysics.Reset();
+			PhysicsToPresent.Reset();
+			InputToPresent.Reset();
+			FrameTime.Reset();
+		}
+
+		// Drop samples still in flight, their timestamps would be stale in the next session
+		PendingInputCycles = 0;
+		AwaitingPhysics.Reset();
+		AwaitingFrame.Reset();
+
+		if (RenderState.IsValid())
+		{
+			FScopeLock Lock(&RenderState->CompletedLock);
+			RenderState->Completed.Reset();
+		}
+		return;
+	}
+
+	FrameTime.Add((float)FApp::GetDeltaTime() * 1000.0f);
+
+	TArray<FLatencySample> Completed;
+	if (RenderState.IsValid())
+	{
+		FScopeLock Lock(&RenderState->CompletedLock);
+		Completed = MoveTemp(RenderState->Completed);
+		RenderState->Completed.Reset();
+	}
+
+	for (const FLatencySample& Sample : Completed)
+	{
+		InputToApply.Add((float)FPlatformTime::ToMilliseconds64(Sample.AppliedCycles - Sample.InputCycles));
+		ApplyToPhysics.Add((float)FPlatformTime::ToMilliseconds64(Sample.PhysicsCycles - Sample.AppliedCycles));
+		PhysicsToPresent.Add((float)FPlatformTime::ToMilliseconds64(Sample.PresentCycles - Sample.PhysicsCycles));
+		InputToPresent.Add((float)FPlatformTime::ToMilliseconds64(Sample.PresentCycles - Sample.InputCycles));
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastReportTime >= CVarLatencyProbeReportInterval.GetValueOnGameThread())
+	{
+		LastReportTime = Now;
+		ReportHistograms();
+	}
+}
+
+void UInputLatencyProbeSubsystem::ReportHistograms()
+{
+	struct FStage
+	{
+		const TCHAR* Name;
+		FLatencyHistogram* Histogram;
+	};
+
+	const FStage Stages[] = {
+		{ TEXT("Input -> Torque"), &InputToApply },
+		{ TEXT("Torque -> Physics"), &ApplyToPhysics },
+		{ TEXT("Physics -> Present"), &PhysicsToPresent },
+		{ TEXT("Input -> Present"), &InputToPresent },
+		{ TEXT("Frame time"), &FrameTime },
+	};
+
+	const float DisplayTime = CVarLatencyProbeReportInterval.GetValueOnGameThread() + 0.5f;
+
+	for (int32 StageIndex = 0; StageIndex < UE_ARRAY_COUNT(Stages); ++StageIndex)
+	{
+		const FStage& Stage = Stages[StageIndex];
+
+		const FString Summary = FString::Printf(TEXT("%-20s p50 %6.2f  p90 %6.2f  p99 %6.2f  max %6.2f ms  (%d samples)"),
+			Stage.Name,
+			Stage.Histogram->GetPercentile(0.5f),
+			Stage.Histogram->GetPercentile(0.9f),
+			Stage.Histogram->GetPercentile(0.99f),
+			Stage.Histogram->GetPercentile(1.0f),
+			Stage.Histogram->Num());
+
+		UE_LOG(LogInputLatency, Log, TEXT("%s"), *Summary);
+		UE_LOG(LogInputLatency, Log, TEXT("%-20s %s"), TEXT(""), *Stage.Histogram->ToString());
+
+		if (GEngine)
+		{
+			// Stable keys, so each stage replaces its previous line
+			const uint64 OnScreenKey = GetUniqueID() * 8 + StageIndex;
+			GEngine->AddOnScreenDebugMessage(OnScreenKey, DisplayTime, FColor::Yellow, Summary);
+		}
+	}
+}
@@ -0,0 +1,253 @@
+#include "ProjectFlyReborn/Public/Environment/WindFieldSubsystem.h"
+#include "ProjectFlyReborn/Public/Environment/WindVolume.h"
+#include "Async/ParallelFor.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarWindFieldCellSize(
+	TEXT("fly.WindField.CellSize"),
+	1000.0f,
+	TEXT("Requested size of a baked wind field cell (cm). Grows automatically if the brick budget is exceeded."));
+
+static TAutoConsoleVariable<int32> CVarWindFieldMaxBricks(
+	TEXT("fly.WindField.MaxBricks"),
+	1024,
+	TEXT("Maximum number of allocated wind field bricks (each brick is 9^3 samples)."));
+
+static TAutoConsoleVariable<int32> CVarWindFieldMaxIndexBricks(
+	TEXT("fly.WindField.MaxIndexBricks"),
+	262144,
+	TEXT("Maximum size of the wind field brick index grid, limits index memory when volumes are far apart."));
+
+void UWindFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	RebuildWindField();
+}
+
+void UWindFieldSubsystem::Deinitialize()
+{
+	Reset();
+
+	Super::Deinitialize();
+}
+
+void UWindFieldSubsystem::Reset()
+{
+	Origin = FVector::ZeroVector;
+	CellSize = 0.0;
+	InvCellSize = 0.0;
+	CellCount = FIntVector::ZeroValue;
+	BrickCount = FIntVector::ZeroValue;
+	BrickIndices.Empty();
+	Bricks.Empty();
+}
+
+void UWindFieldSubsystem::RebuildWindField()
+{
+	Reset();
+
+	TArray<const AWindVolume*> Volumes;
+	TArray<FBox> VolumeBounds;
+	FBox FieldBounds(ForceInit);
+
+	for (TActorIterator<AWindVolume> It(GetWorld()); It; ++It)
+	{
+		if (!It->HasValidExtent())
+		{
+			continue;
+		}
+
+		const FBox Bounds = It->GetWindBounds();
+		if (Bounds.IsValid)
+		{
+			Volumes.Add(*It);
+			VolumeBounds.Add(Bounds);
+			FieldBounds += Bounds;
+		}
+	}
+
+	if (Volumes.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 MaxBricks = FMath::Max(1, CVarWindFieldMaxBricks.GetValueOnGameThread());
+	const int64 MaxIndexBricks = FMath::Max(1, CVarWindFieldMaxIndexBricks.GetValueOnGameThread());
+	const FVector FieldSize = FieldBounds.GetSize();
+
+	Origin = FieldBounds.Min;
+	CellSize = FMath::Max(1.0, (double)CVarWindFieldCellSize.GetValueOnGameThread());
+
+	// Mark bricks touched by any volume, coarsen the grid until both index grid and bricks fit in the budget
+	TBitArray<> UsedBricks;
+	int32 UsedBrickNum = 0;
+
+	for (;;)
+	{
+		CellCount = FIntVector(
+			FMath::Max(1, FMath::CeilToInt(FieldSize.X / CellSize)),
+			FMath::Max(1, FMath::CeilToInt(FieldSize.Y / CellSize)),
+			FMath::Max(1, FMath::CeilToInt(FieldSize.Z / CellSize)));
+
+		BrickCount = FIntVector(
+			FMath::DivideAndRoundUp(CellCount.X, BrickCells),
+			FMath::DivideAndRoundUp(CellCount.Y, BrickCells),
+			FMath::DivideAndRoundUp(CellCount.Z, BrickCells));
+
+		// Index grid grows with the bounds of all volumes, not only with the used bricks
+		if ((int64)BrickCount.X * BrickCount.Y * BrickCount.Z > MaxIndexBricks)
+		{
+			CellSize *= 2.0;
+			continue;
+		}
+
+		const double BrickSize = CellSize * BrickCells;
+
+		UsedBricks.Init(false, BrickCount.X * BrickCount.Y * BrickCount.Z);
+		UsedBrickNum = 0;
+
+		for (const FBox& Bounds : VolumeBounds)
+		{
+			const FIntVector Min(
+				FMath::Clamp(FMath::FloorToInt((Bounds.Min.X - Origin.X) / BrickSize), 0, BrickCount.X - 1),
+				FMath::Clamp(FMath::FloorToInt((Bounds.Min.Y - Origin.Y) / BrickSize), 0, BrickCount.Y - 1),
+				FMath::Clamp(FMath::FloorToInt((Bounds.Min.Z - Origin.Z) / BrickSize), 0, BrickCount.Z - 1));
+			const FIntVector Max(
+				FMath::Clamp(FMath::FloorToInt((Bounds.Max.X - Origin.X) / BrickSize), 0, BrickCount.X - 1),
+				FMath::Clamp(FMath::FloorToInt((Bounds.Max.Y - Origin.Y) / BrickSize), 0, BrickCount.Y - 1),
+				FMath::Clamp(FMath::FloorToInt((Bounds.Max.Z - Origin.Z) / BrickSize), 0, BrickCount.Z - 1));
+
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+				{
+					for (int32 X = Min.X; X <= Max.X; ++X)
+					{
+						const int32 Index = (Z * BrickCount.Y + Y) * BrickCount.X + X;
+						if (!UsedBricks[Index])
+						{
+							UsedBricks[Index] = true;
+							++UsedBrickNum;
+						}
+					}
+				}
+			}
+		}
+
+		if (UsedBrickNum <= MaxBricks)
+		{
+			break;
+		}
+
+		CellSize *= 2.0;
+	}
+
+	InvCellSize = 1.0 / CellSize;
+
+	// Assign storage to used bricks
+	TArray<FIntVector> BrickCoords;
+	BrickCoords.Reserve(UsedBrickNum);
+	BrickIndices.Init(INDEX_NONE, UsedBricks.Num());
+
+	for (int32 Z = 0; Z < BrickCount.Z; ++Z)
+	{
+		for (int32 Y = 0; Y < BrickCount.Y; ++Y)
+		{
+			for (int32 X = 0; X < BrickCount.X; ++X)
+			{
+				const int32 Index = (Z * BrickCount.Y + Y) * BrickCount.X + X;
+				if (UsedBricks[Index])
+				{
+					BrickIndices[Index] = BrickCoords.Add(FIntVector(X, Y, Z));
+				}
+			}
+		}
+	}
+
+	Bricks.SetNumUninitialized(UsedBrickNum * SamplesPerBrick);
+
+	// Bake samples, bricks are independent so they can be filled in parallel
+	ParallelFor(BrickCoords.Num(), [this, &BrickCoords, &Volumes, &VolumeBounds](int32 BrickIndex)
+	{
+		const FIntVector FirstCell = BrickCoords[BrickIndex] * BrickCells;
+		const FVector BrickMin = Origin + FVector(FirstCell) * CellSize;
+		const FBox BrickBounds(BrickMin, BrickMin + FVector(BrickCells * CellSize));
+
+		TArray<const AWindVolume*, TInlineAllocator<8>> BrickVolumes;
+		for (int32 VolumeIndex = 0; VolumeIndex < Volumes.Num(); ++VolumeIndex)
+		{
+			if (VolumeBounds[VolumeIndex].Intersect(BrickBounds))
+			{
+				BrickVolumes.Add(Volumes[VolumeIndex]);
+			}
+		}
+
+		FVector3f* Samples = &Bricks[BrickIndex * SamplesPerBrick];
+
+		for (int32 Z = 0; Z < BrickSamples; ++Z)
+		{
+			for (int32 Y = 0; Y < BrickSamples; ++Y)
+			{
+				for (int32 X = 0; X < BrickSamples; ++X)
+				{
+					const FVector SampleLocation = BrickMin + FVector(X, Y, Z) * CellSize;
+
+					FVector Wind = FVector::ZeroVector;
+					for (const AWindVolume* Volume : BrickVolumes)
+					{
+						Wind += Volume->EvaluateWind(SampleLocation);
+					}
+
+					Samples[(Z * BrickSamples + Y) * BrickSamples + X] = FVector3f(Wind);
+				}
+			}
+		}
+	});
+}
+
+FVector UWindFieldSubsystem::SampleWind(const FVector& WorldLocation) const
+{
+	if (Bricks.Num() == 0)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FVector CellSpace = (WorldLocation - Origin) * InvCellSize;
+
+	if (CellSpace.X < 0.0 || CellSpace.Y < 0.0 || CellSpace.Z < 0.0 ||
+		CellSpace.X >= CellCount.X || CellSpace.Y >= CellCount.Y || CellSpace.Z >= CellCount.Z)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FIntVector Cell(FMath::FloorToInt(CellSpace.X), FMath::FloorToInt(CellSpace.Y), FMath::FloorToInt(CellSpace.Z));
+	const FIntVector Brick(Cell.X / BrickCells, Cell.Y / BrickCells, Cell.Z / BrickCells);
+
+	const int32 BrickIndex = BrickIndices[(Brick.Z * BrickCount.Y + Brick.Y) * BrickCount.X + Brick.X];
+	if (BrickIndex == INDEX_NONE)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FIntVector Local = Cell - Brick * BrickCells;
+	const FVector3f* Samples = &Bricks[BrickIndex * SamplesPerBrick + (Local.Z * BrickSamples + Local.Y) * BrickSamples + Local.X];
+
+	constexpr int32 StrideY = BrickSamples;
+	constexpr int32 StrideZ = BrickSamples * BrickSamples;
+
+	const float FracX = (float)(CellSpace.X - Cell.X);
+	const float FracY = (float)(CellSpace.Y - Cell.Y);
+	const float FracZ = (float)(CellSpace.Z - Cell.Z);
+
+	const FVector3f X00 = FMath::Lerp(Samples[0], Samples[1], FracX);
+	const FVector3f X10 = FMath::Lerp(Samples[StrideY], Samples[StrideY + 1], FracX);
+	const FVector3f X01 = FMath::Lerp(Samples[StrideZ], Samples[StrideZ + 1], FracX);
+	const FVector3f X11 = FMath::Lerp(Samples[StrideZ + StrideY], Samples[StrideZ + StrideY + 1], FracX);
+
+	const FVector3f Y0 = FMath::Lerp(X00, X10, FracY);
+	const FVector3f Y1 = FMath::Lerp(X01, X11, FracY);
+
+	return FVector(FMath::Lerp(Y0, Y1, FracZ));
+}
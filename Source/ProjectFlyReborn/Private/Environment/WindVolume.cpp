@@ -0,0 +1,59 @@
+#include "ProjectFlyReborn/Public/Environment/WindVolume.h"
+#include "Components/BoxComponent.h"
+
+AWindVolume::AWindVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	BoxComponent = CreateDefaultSubobject<UBoxComponent>(TEXT("BoxComponent"));
+	BoxComponent->SetBoxExtent(FVector(5000.0f, 5000.0f, 5000.0f));
+	BoxComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	BoxComponent->SetMobility(EComponentMobility::Static);
+	BoxComponent->ShapeColor = FColor::Cyan;
+	RootComponent = BoxComponent;
+}
+
+FVector AWindVolume::EvaluateWind(const FVector& WorldLocation) const
+{
+	const FTransform& BoxTransform = BoxComponent->GetComponentTransform();
+	const FVector Extent = BoxComponent->GetUnscaledBoxExtent();
+
+	// Normalized local position, [-1..1] inside the box
+	const FVector Local = BoxTransform.InverseTransformPosition(WorldLocation) / Extent;
+	const FVector AbsLocal = Local.GetAbs();
+
+	if (AbsLocal.GetMax() > 1.0f)
+	{
+		return FVector::ZeroVector;
+	}
+
+	// Fade in from the box faces so neighbouring cells do not see a hard step
+	float EdgeWeight = 1.0f;
+	if (EdgeFalloff > KINDA_SMALL_NUMBER)
+	{
+		EdgeWeight = FMath::Clamp((1.0f - AbsLocal.GetMax()) / EdgeFalloff, 0.0f, 1.0f);
+	}
+
+	FVector Wind = WindVelocity;
+
+	if (bIsThermal)
+	{
+		// Column shaped updraft, strongest around the vertical axis of the box
+		const float Radius = FVector2D(Local.X, Local.Y).Size();
+		const float RadialWeight = 1.0f - FMath::SmoothStep(ThermalCoreRadius, 1.0f, Radius);
+
+		Wind.Z += ThermalUpdraft * RadialWeight;
+	}
+
+	return Wind * EdgeWeight;
+}
+
+FBox AWindVolume::GetWindBounds() const
+{
+	return BoxComponent->Bounds.GetBox();
+}
+
+bool AWindVolume::HasValidExtent() const
+{
+	return BoxComponent->GetUnscaledBoxExtent().GetMin() > KINDA_SMALL_NUMBER;
+}
@@ -0,0 +1,213 @@
+#include "ProjectFlyReborn/Public/Flight/FlightAvoidanceSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarAvoidanceMaxTracesPerFrame(
+	TEXT("fly.Avoidance.MaxTracesPerFrame"),
+	32,
+	TEXT("Maximum number of look-ahead sweeps issued per frame for all aircraft."));
+
+static TAutoConsoleVariable<float> CVarAvoidanceBudgetMs(
+	TEXT("fly.Avoidance.BudgetMs"),
+	0.25f,
+	TEXT("Game thread time budget (ms) for issuing look-ahead sweeps per frame."));
+
+static TAutoConsoleVariable<float> CVarAvoidanceLookAheadTime(
+	TEXT("fly.Avoidance.LookAheadTime"),
+	2.0f,
+	TEXT("How far ahead (seconds at current velocity) aircraft probe for obstacles."));
+
+static TAutoConsoleVariable<float> CVarAvoidanceFadeTime(
+	TEXT("fly.Avoidance.FadeTime"),
+	0.75f,
+	TEXT("Minimal time (seconds) over which an avoidance result fades out, so pull-up does not persist after the path is clear. Never shorter than the time until the aircraft is probed again."));
+
+static TAutoConsoleVariable<float> CVarAvoidanceMinDistance(
+	TEXT("fly.Avoidance.MinDistance"),
+	2000.0f,
+	TEXT("Minimal look-ahead distance (cm), used when aircraft is slow."));
+
+static TAutoConsoleVariable<float> CVarAvoidanceProbeRadius(
+	TEXT("fly.Avoidance.ProbeRadius"),
+	150.0f,
+	TEXT("Radius of look-ahead sphere sweep (cm)."));
+
+void UFlightAvoidanceSubsystem::Deinitialize()
+{
+	Probes.Empty();
+	ProbeIndices.Empty();
+	IssuedTraceRate = 0.0f;
+
+	Super::Deinitialize();
+}
+
+TStatId UFlightAvoidanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlightAvoidanceSubsystem, STATGROUP_Tickables);
+}
+
+void UFlightAvoidanceSubsystem::RegisterAircraft(APawn* Aircraft)
+{
+	if (Aircraft && !ProbeIndices.Contains(Aircraft))
+	{
+		FAircraftProbe& Probe = Probes.AddDefaulted_GetRef();
+		Probe.Aircraft = Aircraft;
+		Probe.AircraftKey = Aircraft;
+
+		ProbeIndices.Add(Aircraft, Probes.Num() - 1);
+	}
+}
+
+void UFlightAvoidanceSubsystem::UnregisterAircraft(APawn* Aircraft)
+{
+	int32 Index;
+	if (!ProbeIndices.RemoveAndCopyValue(Aircraft, Index))
+	{
+		return;
+	}
+
+	Probes.RemoveAtSwap(Index);
+
+	// Fix index of the probe moved into removed slot
+	if (Probes.IsValidIndex(Index))
+	{
+		ProbeIndices.Add(Probes[Index].AircraftKey, Index);
+	}
+}
+
+FVector UFlightAvoidanceSubsystem::GetAvoidance(const APawn* Aircraft) const
+{
+	const int32* Index = ProbeIndices.Find(Aircraft);
+	if (!Index)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FAircraftProbe& Probe = Probes[*Index];
+	if (Probe.Avoidance.IsZero())
+	{
+		return FVector::ZeroVector;
+	}
+
+	// Result is not refreshed before the next probe, so it must not fade out sooner
+	const float FadeTime = FMath::Max(CVarAvoidanceFadeTime.GetValueOnGameThread(), Probe.RevisitTime);
+	const float Age = (float)(GetWorld()->GetTimeSeconds() - Probe.ResultTime);
+	const float Fade = FadeTime > KINDA_SMALL_NUMBER ? FMath::Clamp(1.0f - Age / FadeTime, 0.0f, 1.0f) : 1.0f;
+
+	return Probe.Avoidance * Fade;
+}
+
+void UFlightAvoidanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Probes.Num() == 0)
+	{
+		return;
+	}
+
+	ReadTraceResults();
+	IssueTraces(DeltaTime);
+}
+
+void UFlightAvoidanceSubsystem::ReadTraceResults()
+{
+	UWorld* World = GetWorld();
+
+	for (FAircraftProbe& Probe : Probes)
+	{
+		if (!Probe.PendingTrace.IsValid())
+		{
+			continue;
+		}
+
+		FTraceDatum TraceData;
+		if (!World->QueryTraceData(Probe.PendingTrace, TraceData))
+		{
+			// Result was already discarded by the world, probe again later
+			if (!World->IsTraceHandleValid(Probe.PendingTrace, false))
+			{
+				Probe.PendingTrace = FTraceHandle();
+			}
+			continue;
+		}
+
+		Probe.PendingTrace = FTraceHandle();
+		Probe.ResultTime = World->GetTimeSeconds();
+
+		const FHitResult* Hit = TraceData.OutHits.FindByPredicate([](const FHitResult& Result) { return Result.bBlockingHit; });
+		if (!Hit)
+		{
+			Probe.Avoidance = FVector::ZeroVector;
+			continue;
+		}
+
+		// Closer the obstacle the harder we pull away, pulling up is preferred over turning
+		const float Urgency = 1.0f - Hit->Time;
+		const FVector AwayDirection = (Hit->ImpactNormal + FVector::UpVector * 0.5f).GetSafeNormal();
+
+		Probe.Avoidance = AwayDirection * Urgency;
+	}
+}
+
+void UFlightAvoidanceSubsystem::IssueTraces(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+
+	const int32 MaxTraces = FMath::Clamp(CVarAvoidanceMaxTracesPerFrame.GetValueOnGameThread(), 1, Probes.Num());
+	const double BudgetEndTime = FPlatformTime::Seconds() + CVarAvoidanceBudgetMs.GetValueOnGameThread() * 0.001;
+
+	// Aircraft is probed again only after all others had their turn, sweep has to cover that wait as well
+	// Wait is estimated from traces actually issued, time budget can cut a frame short of MaxTraces
+	const float SafeDeltaTime = FMath::Max(DeltaTime, KINDA_SMALL_NUMBER);
+	const float TraceRate = IssuedTraceRate > 0.0f ? IssuedTraceRate : MaxTraces / SafeDeltaTime;
+	const float RevisitTime = Probes.Num() / TraceRate;
+	const float LookAheadTime = CVarAvoidanceLookAheadTime.GetValueOnGameThread() + RevisitTime;
+	const float MinDistance = CVarAvoidanceMinDistance.GetValueOnGameThread();
+	const FCollisionShape ProbeShape = FCollisionShape::MakeSphere(CVarAvoidanceProbeRadius.GetValueOnGameThread());
+	const FCollisionObjectQueryParams ObjectParams(FCollisionObjectQueryParams::AllStaticObjects);
+
+	int32 IssuedTraces = 0;
+
+	for (int32 Visited = 0; Visited < Probes.Num() && IssuedTraces < MaxTraces; ++Visited)
+	{
+		NextProbe = NextProbe % Probes.Num();
+		FAircraftProbe& Probe = Probes[NextProbe++];
+
+		APawn* Aircraft = Probe.Aircraft.Get();
+		if (!Aircraft || Probe.PendingTrace.IsValid())
+		{
+			continue;
+		}
+
+		const FVector Start = Aircraft->GetActorLocation();
+		const FVector Velocity = Aircraft->GetVelocity();
+		const FVector Direction = Velocity.IsNearlyZero() ? Aircraft->GetActorForwardVector() : Velocity.GetUnsafeNormal();
+		const float Distance = FMath::Max(MinDistance, Velocity.Size() * LookAheadTime);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FlightAvoidance), false, Aircraft);
+
+		Probe.PendingTrace = World->AsyncSweepByObjectType(
+			EAsyncTraceType::Single,
+			Start,
+			Start + Direction * Distance,
+			FQuat::Identity,
+			ObjectParams,
+			ProbeShape,
+			QueryParams
+		);
+		Probe.RevisitTime = RevisitTime;
+
+		++IssuedTraces;
+
+		if (FPlatformTime::Seconds() > BudgetEndTime)
+		{
+			break;
+		}
+	}
+
+	// Smoothed, so a single short frame does not swing look-ahead distance of the whole fleet
+	const float FrameTraceRate = IssuedTraces / SafeDeltaTime;
+	IssuedTraceRate = IssuedTraceRate > 0.0f ? FMath::Lerp(IssuedTraceRate, FrameTraceRate, 0.1f) : FrameTraceRate;
+}
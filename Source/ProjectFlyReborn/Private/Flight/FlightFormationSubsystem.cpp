@@ -0,0 +1,242 @@
+#include "ProjectFlyReborn/Public/Flight/FlightFormationSubsystem.h"
+#include "ProjectFlyReborn/Public/Interface/FlightMouseAimInterface.h"
+#include "ProjectFlyReborn/Public/Pawn/GliderPawn.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarFormationPredictionTime(
+	TEXT("fly.Formation.PredictionTime"),
+	0.5f,
+	TEXT("How far ahead (seconds) leader pose is predicted when placing follower slots."));
+
+static TAutoConsoleVariable<float> CVarFormationLookAheadDistance(
+	TEXT("fly.Formation.LookAheadDistance"),
+	3000.0f,
+	TEXT("Distance (cm) in front of the slot followers steer to, smaller values converge to the slot faster."));
+
+static TAutoConsoleVariable<int32> CVarFormationFullRateFollowers(
+	TEXT("fly.Formation.FullRateFollowers"),
+	16,
+	TEXT("Followers of a formation updated every frame, larger formations spread updates over several frames."));
+
+static TAutoConsoleVariable<float> CVarFormationSlotStiffness(
+	TEXT("fly.Formation.SlotStiffness"),
+	0.5f,
+	TEXT("Forward acceleration (cm/s^2) of a glider follower per cm it is behind its slot, critically damped by the closing speed. 0 disables slot keeping."));
+
+void UFlightFormationSubsystem::Deinitialize()
+{
+	Formations.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UFlightFormationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlightFormationSubsystem, STATGROUP_Tickables);
+}
+
+int32 UFlightFormationSubsystem::CreateFormation(APawn* Leader, EFlightFormationShape Shape, float Spacing)
+{
+	if (!Leader)
+	{
+		return INDEX_NONE;
+	}
+
+	FFormation& Formation = Formations.AddDefaulted_GetRef();
+	Formation.Id = NextFormationId++;
+	Formation.Leader = Leader;
+	Formation.Shape = Shape;
+	Formation.Spacing = Spacing;
+	Formation.LastHeading = FVector(Leader->GetActorForwardVector().X, Leader->GetActorForwardVector().Y, 0.0f).GetSafeNormal();
+
+	if (Formation.LastHeading.IsZero())
+	{
+		Formation.LastHeading = FVector::ForwardVector;
+	}
+
+	return Formation.Id;
+}
+
+void UFlightFormationSubsystem::DestroyFormation(int32 FormationId)
+{
+	Formations.RemoveAllSwap([FormationId](const FFormation& Formation) { return Formation.Id == FormationId; });
+}
+
+bool UFlightFormationSubsystem::AddFollower(int32 FormationId, APawn* Follower)
+{
+	FFormation* Formation = FindFormation(FormationId);
+	if (!Formation || !Cast<IFlightMouseAimInterface>(Follower) || Follower == Formation->Leader.Get())
+	{
+		return false;
+	}
+
+	if (Formation->Followers.ContainsByPredicate([Follower](const FFormationFollower& Existing) { return Existing.Pawn == Follower; }))
+	{
+		return false;
+	}
+
+	FFormationFollower& NewFollower = Formation->Followers.AddDefaulted_GetRef();
+	NewFollower.Pawn = Follower;
+	NewFollower.SlotOffset = CalculateSlotOffset(Formation->Shape, Formation->Spacing, Formation->Followers.Num() - 1);
+
+	return true;
+}
+
+void UFlightFormationSubsystem::RemoveFollower(int32 FormationId, APawn* Follower)
+{
+	FFormation* Formation = FindFormation(FormationId);
+	if (!Formation)
+	{
+		return;
+	}
+
+	if (Formation->Followers.RemoveAll([Follower](const FFormationFollower& Existing) { return Existing.Pawn == Follower; }) > 0)
+	{
+		ReassignSlots(*Formation);
+	}
+}
+
+void UFlightFormationSubsystem::ReassignSlots(FFormation& Formation)
+{
+	// Followers behind the gap move one slot forward
+	for (int32 Index = 0; Index < Formation.Followers.Num(); ++Index)
+	{
+		Formation.Followers[Index].SlotOffset = CalculateSlotOffset(Formation.Shape, Formation.Spacing, Index);
+	}
+}
+
+UFlightFormationSubsystem::FFormation* UFlightFormationSubsystem::FindFormation(int32 FormationId)
+{
+	return Formations.FindByPredicate([FormationId](const FFormation& Formation) { return Formation.Id == FormationId; });
+}
+
+FVector UFlightFormationSubsystem::CalculateSlotOffset(EFlightFormationShape Shape, float Spacing, int32 SlotIndex)
+{
+	// Rank is distance from the leader in slots, starting from 1
+	switch (Shape)
+	{
+	case EFlightFormationShape::Vee:
+	{
+		const float Rank = (float)(SlotIndex / 2 + 1);
+		const float Side = SlotIndex % 2 == 0 ? 1.0f : -1.0f;
+		return FVector(-Rank * Spacing, Side * Rank * Spacing, 0.0f);
+	}
+	case EFlightFormationShape::Echelon:
+	{
+		const float Rank = (float)(SlotIndex + 1);
+		return FVector(-Rank * Spacing, Rank * Spacing, 0.0f);
+	}
+	case EFlightFormationShape::LineAbreast:
+	{
+		const float Rank = (float)(SlotIndex / 2 + 1);
+		const float Side = SlotIndex % 2 == 0 ? 1.0f : -1.0f;
+		return FVector(0.0f, Side * Rank * Spacing, 0.0f);
+	}
+	case EFlightFormationShape::Column:
+	default:
+	{
+		const float Rank = (float)(SlotIndex + 1);
+		return FVector(-Rank * Spacing, 0.0f, 0.0f);
+	}
+	}
+}
+
+void UFlightFormationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Formations without leader are dissolved, followers keep flying to their last target
+	Formations.RemoveAllSwap([](const FFormation& Formation) { return !Formation.Leader.IsValid(); });
+
+	for (FFormation& Formation : Formations)
+	{
+		UpdateFormation(Formation, DeltaTime);
+	}
+}
+
+void UFlightFormationSubsystem::UpdateFormation(FFormation& Formation, float DeltaTime)
+{
+	// Destroyed followers leave no holes in the formation
+	if (Formation.Followers.RemoveAll([](const FFormationFollower& Follower) { return !Follower.Pawn.IsValid(); }) > 0)
+	{
+		ReassignSlots(Formation);
+	}
+
+	if (Formation.Followers.Num() == 0)
+	{
+		return;
+	}
+
+	// Predict leader pose once for the whole formation
+	const APawn* Leader = Formation.Leader.Get();
+	const float PredictionTime = CVarFormationPredictionTime.GetValueOnGameThread();
+
+	FQuat LeaderRotation = Leader->GetActorQuat();
+	if (const UPrimitiveComponent* LeaderBody = Cast<UPrimitiveComponent>(Leader->GetRootComponent()))
+	{
+		const FVector AngularVelocity = LeaderBody->GetPhysicsAngularVelocityInRadians();
+		const float Angle = AngularVelocity.Size() * PredictionTime;
+
+		if (Angle > KINDA_SMALL_NUMBER)
+		{
+			LeaderRotation = FQuat(AngularVelocity.GetUnsafeNormal(), Angle) * LeaderRotation;
+		}
+	}
+
+	const FVector LeaderLocation = Leader->GetActorLocation();
+	const FVector LeaderVelocity = Leader->GetVelocity();
+	const FVector PredictedLocation = LeaderLocation + LeaderVelocity * PredictionTime;
+
+	// Slots follow leader heading without roll, so banking leader does not swing the whole formation
+	// Heading is undefined in a vertical dive, sides of the formation are then kept from the last horizontal heading
+	const FVector PredictedForward = LeaderRotation.GetForwardVector();
+	if (FMath::Abs(PredictedForward.Z) < 0.98f)
+	{
+		Formation.LastHeading = FVector(PredictedForward.X, PredictedForward.Y, 0.0f).GetSafeNormal();
+	}
+
+	const FVector HeadingRight = FVector::CrossProduct(FVector::UpVector, Formation.LastHeading);
+	const FMatrix HeadingFrame = FRotationMatrix::MakeFromXY(PredictedForward, HeadingRight);
+
+	const FVector LookAhead = PredictedForward * CVarFormationLookAheadDistance.GetValueOnGameThread();
+
+	// Large formations update only every N-th follower per frame, staggered by frame
+	const int32 FullRateFollowers = FMath::Max(1, CVarFormationFullRateFollowers.GetValueOnGameThread());
+	const int32 UpdateInterval = FMath::DivideAndRoundUp(Formation.Followers.Num(), FullRateFollowers);
+	const int32 FirstFollower = Formation.UpdateFrame++ % UpdateInterval;
+
+	// Steering alone does not change distance along the path, gliders hold it with extra thrust
+	// Spring on the along-track error, critically damped by the closing speed. It is recomputed on every update
+	// and held until the next one, so nothing accumulates between updates
+	const float SlotStiffness = FMath::Max(0.0f, CVarFormationSlotStiffness.GetValueOnGameThread());
+	const float SlotDamping = 2.0f * FMath::Sqrt(SlotStiffness);
+	const float HoldTime = DeltaTime * (UpdateInterval + 1);
+
+	for (int32 Index = FirstFollower; Index < Formation.Followers.Num(); Index += UpdateInterval)
+	{
+		const FFormationFollower& Follower = Formation.Followers[Index];
+
+		APawn* FollowerPawn = Follower.Pawn.Get();
+		IFlightMouseAimInterface* Steering = Cast<IFlightMouseAimInterface>(FollowerPawn);
+		if (!Steering)
+		{
+			continue;
+		}
+
+		const FVector SlotOffset = HeadingFrame.TransformVector(Follower.SlotOffset);
+
+		Steering->SetDesiredDirection(PredictedLocation + SlotOffset + LookAhead);
+
+		AGliderPawn* Glider = Cast<AGliderPawn>(FollowerPawn);
+		if (Glider && SlotStiffness > 0.0f)
+		{
+			// Positive when follower is behind its current slot or falling behind
+			const float SlotError = (float)FVector::DotProduct(LeaderLocation + SlotOffset - Glider->GetActorLocation(), PredictedForward);
+			const float ClosingSpeed = (float)FVector::DotProduct(LeaderVelocity - Glider->GetVelocity(), PredictedForward);
+
+			Glider->SetForwardAcceleration(SlotError * SlotStiffness + ClosingSpeed * SlotDamping, HoldTime);
+		}
+	}
+}
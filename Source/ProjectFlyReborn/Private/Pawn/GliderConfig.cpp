@@ -0,0 +1,74 @@
+#include "ProjectFlyReborn/Public/Pawn/GliderConfig.h"
+
+bool FGliderTuning::ClampToLimits()
+{
+	bool bClamped = false;
+
+	// Negated compare so NaN from a broken file is clamped too
+	auto ClampNonNegative = [&bClamped](auto& Value)
+	{
+		if (!(Value >= 0))
+		{
+			Value = 0;
+			bClamped = true;
+		}
+	};
+
+	ClampNonNegative(TurnTorque.X);
+	ClampNonNegative(TurnTorque.Y);
+	ClampNonNegative(TurnTorque.Z);
+	ClampNonNegative(MouseSensitivity);
+	ClampNonNegative(TurnAngleSensitivity);
+	ClampNonNegative(AggressiveTurnAngle);
+	ClampNonNegative(AvoidanceStrength);
+	ClampNonNegative(LiftCoefficientScalar);
+	ClampNonNegative(MaxLiftForce);
+	ClampNonNegative(MinimumPlaneSpeed);
+	ClampNonNegative(MaximumPlaneSpeed);
+	ClampNonNegative(StartPlaneSpeed);
+	ClampNonNegative(DiveSpeedIncreaseScalar);
+	ClampNonNegative(RiseSpeedDecreaseScalar);
+	ClampNonNegative(MinimumAirControl);
+	ClampNonNegative(MaximumAirControl);
+	ClampNonNegative(GravityScalar);
+	ClampNonNegative(GravityMultiplier);
+
+	return bClamped;
+}
+
+UGliderConfig::UGliderConfig()
+{
+	UpdateDerivedValues();
+}
+
+void UGliderConfig::PostLoad()
+{
+	Super::PostLoad();
+
+	UpdateDerivedValues();
+}
+
+#if WITH_EDITOR
+void UGliderConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	UpdateDerivedValues();
+}
+#endif
+
+void UGliderConfig::ApplyTuning(const FGliderTuning& NewTuning)
+{
+	Tuning = NewTuning;
+
+	UpdateDerivedValues();
+}
+
+void UGliderConfig::UpdateDerivedValues()
+{
+	const float PlaneSpeedRange = Tuning.MaximumPlaneSpeed - Tuning.MinimumPlaneSpeed;
+	InvPlaneSpeedRange = FMath::IsNearlyZero(PlaneSpeedRange) ? 0.0f : 1.0f / PlaneSpeedRange;
+
+	const float AirControlRange = Tuning.MaximumAirControl - Tuning.MinimumAirControl;
+	InvAirControlRange = FMath::IsNearlyZero(AirControlRange) ? 0.0f : 1.0f / AirControlRange;
+}
@@ -0,0 +1,151 @@
+#include "ProjectFlyReborn/Public/Pawn/GliderConfigReloadSubsystem.h"
+#include "ProjectFlyReborn/Public/Pawn/GliderConfig.h"
+#include "Engine/Engine.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGliderConfig, Log, All);
+
+static TAutoConsoleVariable<float> CVarGliderConfigPollInterval(
+	TEXT("fly.GliderConfig.PollInterval"),
+	1.0f,
+	TEXT("How often (seconds) tuning files are checked for changes. Read on startup."));
+
+static FAutoConsoleCommand GliderConfigExportCommand(
+	TEXT("fly.GliderConfig.Export"),
+	TEXT("Writes tuning of every loaded glider config to Saved/GliderTuning for live editing."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (GEngine)
+		{
+			if (UGliderConfigReloadSubsystem* ReloadSubsystem = GEngine->GetEngineSubsystem<UGliderConfigReloadSubsystem>())
+			{
+				ReloadSubsystem->ExportLoadedConfigs();
+			}
+		}
+	}));
+
+bool UGliderConfigReloadSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Live tuning is a development feature only
+	return !UE_BUILD_SHIPPING;
+}
+
+void UGliderConfigReloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PollTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UGliderConfigReloadSubsystem::PollTuningFiles),
+		CVarGliderConfigPollInterval.GetValueOnGameThread()
+	);
+}
+
+void UGliderConfigReloadSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(PollTickerHandle);
+	AppliedTimestamps.Empty();
+
+	Super::Deinitialize();
+}
+
+FString UGliderConfigReloadSubsystem::GetTuningFilePath(const UGliderConfig* Config)
+{
+	// Class default object name is not stable across classes, gliders without assigned config use the plain one
+	FString FileName = Config->GetName();
+	if (Config->HasAnyFlags(RF_ClassDefaultObject))
+	{
+		FileName = Config->GetClass() == UGliderConfig::StaticClass() ? TEXT("Default") : TEXT("Default_") + Config->GetClass()->GetName();
+	}
+
+	return FPaths::ProjectSavedDir() / TEXT("GliderTuning") / FileName + TEXT(".json");
+}
+
+void UGliderConfigReloadSubsystem::ExportLoadedConfigs()
+{
+	// Class default objects are included, they are used by every glider without assigned config
+	for (TObjectIterator<UGliderConfig> It(RF_NoFlags); It; ++It)
+	{
+		FString Json;
+		if (FJsonObjectConverter::UStructToJsonObjectString(It->GetTuning(), Json, 0, 0))
+		{
+			const FString FilePath = GetTuningFilePath(*It);
+			if (!FFileHelper::SaveStringToFile(Json, *FilePath))
+			{
+				continue;
+			}
+
+			// Exported file holds current values, no need to apply it back on next poll
+			AppliedTimestamps.Add(*It, IFileManager::Get().GetTimeStamp(*FilePath));
+
+			UE_LOG(LogGliderConfig, Log, TEXT("Exported %s tuning to %s"), *It->GetName(), *FilePath);
+		}
+	}
+}
+
+bool UGliderConfigReloadSubsystem::PollTuningFiles(float DeltaTime)
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	for (TObjectIterator<UGliderConfig> It(RF_NoFlags); It; ++It)
+	{
+		UGliderConfig* Config = *It;
+
+		const FString FilePath = GetTuningFilePath(Config);
+		const FDateTime Timestamp = FileManager.GetTimeStamp(*FilePath);
+
+		// Missing file returns FDateTime::MinValue
+		if (Timestamp == FDateTime::MinValue())
+		{
+			continue;
+		}
+
+		FDateTime* AppliedTimestamp = AppliedTimestamps.Find(Config);
+		if (AppliedTimestamp && Timestamp <= *AppliedTimestamp)
+		{
+			continue;
+		}
+
+		// File seen for the first time was left from an earlier session
+		const bool bStaleFile = AppliedTimestamp == nullptr;
+		AppliedTimestamps.Add(Config, Timestamp);
+
+		FString Json;
+		if (!FFileHelper::LoadFileToString(Json, *FilePath))
+		{
+			continue;
+		}
+
+		// Start from current values, so file can contain only the tuned fields
+		FGliderTuning NewTuning = Config->GetTuning();
+		if (FJsonObjectConverter::JsonObjectStringToUStruct(Json, &NewTuning, 0, 0))
+		{
+			if (NewTuning.ClampToLimits())
+			{
+				UE_LOG(LogGliderConfig, Warning, TEXT("%s has values out of range, clamped to property limits"), *FilePath);
+			}
+
+			Config->ApplyTuning(NewTuning);
+
+			if (bStaleFile)
+			{
+				UE_LOG(LogGliderConfig, Warning, TEXT("%s tuning overridden by existing %s, delete the file to use asset values"), *Config->GetName(), *FilePath);
+			}
+			else
+			{
+				UE_LOG(LogGliderConfig, Log, TEXT("Reloaded %s tuning from %s"), *Config->GetName(), *FilePath);
+			}
+		}
+		else
+		{
+			UE_LOG(LogGliderConfig, Warning, TEXT("Failed to parse %s, keeping current %s tuning"), *FilePath, *Config->GetName());
+		}
+	}
+
+	// Keep ticking
+	return true;
+}
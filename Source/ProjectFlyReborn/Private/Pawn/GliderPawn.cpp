@@ -1,8 +1,18 @@
 ﻿#include "ProjectFlyReborn/Public/Pawn/GliderPawn.h"
+#include "ProjectFlyReborn/Public/Pawn/GliderConfig.h"
+#include "ProjectFlyReborn/Public/Environment/WindFieldSubsystem.h"
+#include "ProjectFlyReborn/Public/Flight/FlightAvoidanceSubsystem.h"
+#include "ProjectFlyReborn/Public/Debug/InputLatencyProbeSubsystem.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarGliderDebugDraw(
+	TEXT("fly.Glider.DebugDraw"),
+	1,
+	TEXT("Draws flight direction, target, lift, wind and gravity lines of every glider. 0 - off, 1 - on."));
 
 AGliderPawn::AGliderPawn()
 {
@@ -49,18 +59,45 @@ void AGliderPawn::SetDesiredDirection(FVector WorldDirection)
 	DesiredDirection = WorldDirection;
 }
 
+const UGliderConfig* AGliderPawn::GetConfig() const
+{
+	return Config ? Config : GetDefault<UGliderConfig>();
+}
+
 void AGliderPawn::BeginPlay()
 {
 	Super::BeginPlay();
 
+	WindField = GetWorld()->GetSubsystem<UWindFieldSubsystem>();
+	LatencyProbe = GetWorld()->GetSubsystem<UInputLatencyProbeSubsystem>();
+
+	Avoidance = GetWorld()->GetSubsystem<UFlightAvoidanceSubsystem>();
+	if (Avoidance)
+	{
+		Avoidance->RegisterAircraft(this);
+	}
+
 	// Add initial speed
-	AffectSpeed(StartPlaneSpeed);
+	AffectSpeed(GetConfig()->GetTuning().StartPlaneSpeed);
+}
+
+void AGliderPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Avoidance)
+	{
+		Avoidance->UnregisterAircraft(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AGliderPawn::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	const FGliderTuning& Tuning = GetConfig()->GetTuning();
+	const bool bDrawDebug = CVarGliderDebugDraw.GetValueOnGameThread() != 0;
+
 	CalculateSpeed(DeltaTime);
 
 	// Clamp and apply camera rotation
@@ -68,14 +105,40 @@ void AGliderPawn::Tick(float DeltaTime)
 	FRotator NewRotation(CameraPitch, CameraYaw, 0.0f);
 	SpringArm->SetWorldRotation(NewRotation);
 
-	// Fly target = camera forward
-	const FVector FlyTarget = MeshComponent->GetComponentLocation() + Camera->GetForwardVector() * 1000.0f;
-	DesiredDirection = FlyTarget;
+	// Fly target = camera forward for player, target given through SetDesiredDirection otherwise.
+	// Then bent away from obstacles found by look-ahead probes
+	const bool bIsPlayerControlled = IsPlayerControlled();
+
+	FVector FlyDirection = Camera->GetForwardVector();
+	if (!bIsPlayerControlled && !DesiredDirection.IsZero())
+	{
+		FlyDirection = (DesiredDirection - MeshComponent->GetComponentLocation()).GetSafeNormal(SMALL_NUMBER, MeshComponent->GetForwardVector());
+	}
+
+	if (Avoidance)
+	{
+		const FVector AvoidanceVector = Avoidance->GetAvoidance(this);
+		const float AvoidanceBlend = FMath::Clamp(AvoidanceVector.Size() * Tuning.AvoidanceStrength, 0.0f, 1.0f);
+
+		if (AvoidanceBlend > 0.0f)
+		{
+			FlyDirection = FMath::Lerp(FlyDirection, AvoidanceVector.GetUnsafeNormal(), AvoidanceBlend).GetSafeNormal(SMALL_NUMBER, FlyDirection);
+		}
+	}
+
+	const FVector FlyTarget = MeshComponent->GetComponentLocation() + FlyDirection * 1000.0f;
+	if (bIsPlayerControlled)
+	{
+		DesiredDirection = FlyTarget;
+	}
 
 	// Debug lines
 	const FVector Start = MeshComponent->GetComponentLocation();
-	DrawDebugLine(GetWorld(), Start, Start + MeshComponent->GetForwardVector() * 1000.0f, FColor::Cyan, false, 0.1f, 0, 2.0f);
-	DrawDebugLine(GetWorld(), Start, FlyTarget, FColor::Red, false, 0.1f, 0, 2.0f);
+	if (bDrawDebug)
+	{
+		DrawDebugLine(GetWorld(), Start, Start + MeshComponent->GetForwardVector() * 1000.0f, FColor::Cyan, false, 0.1f, 0, 2.0f);
+		DrawDebugLine(GetWorld(), Start, FlyTarget, FColor::Red, false, 0.1f, 0, 2.0f);
+	}
 
 	// Autopilot torque calculation
 	float YawInput, PitchInput, RollInput;
@@ -83,15 +146,24 @@ void AGliderPawn::Tick(float DeltaTime)
 
 	// Apply torque (arcade feel: strong responsiveness)
 	const FVector Torque = FVector(
-		RollInput * TurnTorque.X,
-		PitchInput * TurnTorque.Y,
-		YawInput * TurnTorque.Z
+		RollInput * Tuning.TurnTorque.X,
+		PitchInput * Tuning.TurnTorque.Y,
+		YawInput * Tuning.TurnTorque.Z
 	);
 	MeshComponent->AddTorqueInRadians(MeshComponent->GetComponentRotation().RotateVector(Torque), NAME_None, true);
 
+	if (LatencyProbe && IsLocallyControlled())
+	{
+		LatencyProbe->MarkInputApplied();
+	}
+
 	// Glider simulation
 
-	float Speed = MeshComponent->GetComponentVelocity().Size();
+	// Aerodynamics work with airspeed, which is velocity relative to the surrounding wind
+	const FVector Wind = WindField ? WindField->SampleWind(Start) : FVector::ZeroVector;
+	const FVector Airspeed = MeshComponent->GetComponentVelocity() - Wind;
+
+	float Speed = Airspeed.Size();
 	float AoA = MeshComponent->GetForwardVector().Z;
 
 	float LiftSpeedThreshold = 300.0f;
@@ -111,19 +183,25 @@ void AGliderPawn::Tick(float DeltaTime)
 
 	LiftCoefficient *= SpeedFactor;
 
-	float LiftForceMag = Speed * Speed * LiftCoefficient * LiftCoefficientScalar;
-	LiftForceMag = FMath::Min(LiftForceMag, MaxLiftForce);
+	float LiftForceMag = Speed * Speed * LiftCoefficient * Tuning.LiftCoefficientScalar;
+	LiftForceMag = FMath::Min(LiftForceMag, Tuning.MaxLiftForce);
 	FVector LiftForce = FVector::UpVector * LiftForceMag;
 
 	// Full gravity for snappy fall
-	FVector GravityForce = FVector::DownVector * GravityScalar;
+	FVector GravityForce = FVector::DownVector * Tuning.GravityScalar;
 
 	// Quadratic drag force
 	float DragCoefficient = 0.002f;
-	FVector Velocity = MeshComponent->GetComponentVelocity();
-	FVector DragForce = -Velocity.GetSafeNormal() * Velocity.SizeSquared() * DragCoefficient;
+	FVector DragForce = -Airspeed.GetSafeNormal() * Airspeed.SizeSquared() * DragCoefficient;
+
+	// Requested acceleration only shifts thrust within the range the plane can fly at
+	float Thrust = ForwardSpeed;
+	if (ForwardAcceleration != 0.0f && GetWorld()->GetTimeSeconds() < ForwardAccelerationEndTime)
+	{
+		Thrust = FMath::Clamp(Thrust + ForwardAcceleration * MeshComponent->GetMass(), Tuning.MinimumPlaneSpeed, Tuning.MaximumPlaneSpeed);
+	}
 
-	FVector TotalForce = LiftForce + GravityForce + DragForce + (MeshComponent->GetForwardVector() * ForwardSpeed);
+	FVector TotalForce = LiftForce + GravityForce + DragForce + (MeshComponent->GetForwardVector() * Thrust);
 
 	if (!bIsHalting)
 	{
@@ -131,7 +209,11 @@ void AGliderPawn::Tick(float DeltaTime)
 	}
 
 	// Debug lift and turbulence
-	DrawDebugLine(GetWorld(), Start, Start + LiftForce * 0.01f, FColor::Green, false, 0.1f, 0, 2.0f);
+	if (bDrawDebug)
+	{
+		DrawDebugLine(GetWorld(), Start, Start + LiftForce * 0.01f, FColor::Green, false, 0.1f, 0, 2.0f);
+		DrawDebugLine(GetWorld(), Start, Start + Wind * 0.1f, FColor::Blue, false, 0.1f, 0, 2.0f);
+	}
 
 	// Dramatic gravity addition
 
@@ -175,24 +257,32 @@ void AGliderPawn::Tick(float DeltaTime)
 		static float SmoothedGravityMultiplier = 1.0f;
 		SmoothedGravityMultiplier = FMath::FInterpTo(SmoothedGravityMultiplier, DramaticGravityMultiplier, DeltaTime, 3.0f);
 
-		FVector DramaticGravityForce = FVector::DownVector * GravityScalar * SmoothedGravityMultiplier;
+		FVector DramaticGravityForce = FVector::DownVector * Tuning.GravityScalar * SmoothedGravityMultiplier;
 		MeshComponent->AddForce(DramaticGravityForce);
 
 		// Optional debug
-		DrawDebugLine(GetWorld(), Start, Start + DramaticGravityForce * 0.01f, FColor::Purple, false, 0.1f, 0, 2.0f);
+		if (bDrawDebug)
+		{
+			DrawDebugLine(GetWorld(), Start, Start + DramaticGravityForce * 0.01f, FColor::Purple, false, 0.1f, 0, 2.0f);
+		}
 	}
 }
 
 void AGliderPawn::AffectSpeed(float Speed)
 {
-	ForwardSpeed = FMath::Clamp(ForwardSpeed + Speed, MinimumPlaneSpeed, MaximumPlaneSpeed);
+	const UGliderConfig* GliderConfig = GetConfig();
+	const FGliderTuning& Tuning = GliderConfig->GetTuning();
+
+	ForwardSpeed = FMath::Clamp(ForwardSpeed + Speed, Tuning.MinimumPlaneSpeed, Tuning.MaximumPlaneSpeed);
 
 	// The less speed we have the less control user has over it's plane
-	AirControl = FMath::GetMappedRangeValueClamped(
-		FVector2D(MinimumPlaneSpeed, MaximumPlaneSpeed),
-		FVector2D(MinimumAirControl, MaximumAirControl),
-		ForwardSpeed
-	);
+	AirControl = GliderConfig->GetAirControl(ForwardSpeed);
+}
+
+void AGliderPawn::SetForwardAcceleration(float Acceleration, float Duration)
+{
+	ForwardAcceleration = Acceleration;
+	ForwardAccelerationEndTime = GetWorld()->GetTimeSeconds() + Duration;
 }
 
 void AGliderPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -208,6 +298,8 @@ void AGliderPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponen
 
 void AGliderPawn::CalculateSpeed(float DeltaTime)
 {
+	const FGliderTuning& Tuning = GetConfig()->GetTuning();
+
 	// Calculate plane inclination
 	float Inclination = MeshComponent->GetForwardVector().Z;
 
@@ -217,25 +309,32 @@ void AGliderPawn::CalculateSpeed(float DeltaTime)
 		float DiveFactor = -Inclination; // Convert to positive
 
 		// Example: cube the factor for strong acceleration at steep dives
-		float DiveAcceleration = FMath::Pow(DiveFactor, 3) * DiveSpeedIncreaseScalar;
+		float DiveAcceleration = FMath::Pow(DiveFactor, 3) * Tuning.DiveSpeedIncreaseScalar;
 
 		AffectSpeed(DiveAcceleration * DeltaTime);
 	}
 	else
 	{
 		// Normal rise speed decrease remains linear
-		AffectSpeed(-Inclination * RiseSpeedDecreaseScalar * DeltaTime);
+		AffectSpeed(-Inclination * Tuning.RiseSpeedDecreaseScalar * DeltaTime);
 	}
 }
 
 void AGliderPawn::Turn(float Value)
 {
-	CameraYaw += Value * MouseSensitivity;
+	CameraYaw += Value * GetConfig()->GetTuning().MouseSensitivity;
+
+	if (LatencyProbe && Value != 0.0f)
+	{
+		LatencyProbe->MarkInput();
+	}
 }
 
 void AGliderPawn::StartDash()
 {
-	if (ForwardSpeed < MinimumPlaneSpeed + DashSpeedCost)
+	const FGliderTuning& Tuning = GetConfig()->GetTuning();
+
+	if (ForwardSpeed < Tuning.MinimumPlaneSpeed + Tuning.DashSpeedCost)
 	{
 		return;
 	}
@@ -245,13 +344,13 @@ void AGliderPawn::StartDash()
 		bCanDash = false;
 
 		// Add impulse, which will imitate dash
-		MeshComponent->AddForce(MeshComponent->GetForwardVector() * DashStrength, NAME_None, true);
+		MeshComponent->AddForce(MeshComponent->GetForwardVector() * Tuning.DashStrength, NAME_None, true);
 
 		// Dash will cost plane forward speed
-		AffectSpeed(-DashSpeedCost);
+		AffectSpeed(-Tuning.DashSpeedCost);
 
 		// Start cooldown
-		GetWorld()->GetTimerManager().SetTimer(DashCooldownTimer, this, &AGliderPawn::ResetDashCooldown, DashCooldown, false);
+		GetWorld()->GetTimerManager().SetTimer(DashCooldownTimer, this, &AGliderPawn::ResetDashCooldown, Tuning.DashCooldown, false);
 	}
 }
 
@@ -262,7 +361,9 @@ void AGliderPawn::ResetDashCooldown()
 
 void AGliderPawn::StartHalt()
 {
-	if (ForwardSpeed < MinimumPlaneSpeed + HaltSpeedCost)
+	const FGliderTuning& Tuning = GetConfig()->GetTuning();
+
+	if (ForwardSpeed < Tuning.MinimumPlaneSpeed + Tuning.HaltSpeedCost)
 	{
 		return;
 	}
@@ -273,15 +374,15 @@ void AGliderPawn::StartHalt()
 		bIsHalting = true;
 
 		// Halt will cost plane forward speed
-		AffectSpeed(-HaltSpeedCost);
+		AffectSpeed(-Tuning.HaltSpeedCost);
 
 		// Save linear damping and velocity before halt
 		LinearDampingBeforeHaltBackup = MeshComponent->GetLinearDamping();
 
 		// Change linear damping to the one, which will be used in halt period
-		MeshComponent->SetLinearDamping(HaltSpeedLinearDamping);
+		MeshComponent->SetLinearDamping(Tuning.HaltSpeedLinearDamping);
 
-		GetWorld()->GetTimerManager().SetTimer(HaltTimer, this, &AGliderPawn::StopHalt, HaltDuration, false);
+		GetWorld()->GetTimerManager().SetTimer(HaltTimer, this, &AGliderPawn::StopHalt, Tuning.HaltDuration, false);
 	}
 }
 
@@ -292,7 +393,7 @@ void AGliderPawn::StopHalt()
 	MeshComponent->SetLinearDamping(LinearDampingBeforeHaltBackup);
 
 	// Start cooldown
-	GetWorld()->GetTimerManager().SetTimer(HaltTimer, this, &AGliderPawn::ResetHaltCooldown, HaltCooldown, false);
+	GetWorld()->GetTimerManager().SetTimer(HaltTimer, this, &AGliderPawn::ResetHaltCooldown, GetConfig()->GetTuning().HaltCooldown, false);
 }
 
 void AGliderPawn::ResetHaltCooldown()
@@ -302,13 +403,21 @@ void AGliderPawn::ResetHaltCooldown()
 
 void AGliderPawn::LookUp(float Value)
 {
-	CameraPitch += Value * MouseSensitivity;
+	CameraPitch += Value * GetConfig()->GetTuning().MouseSensitivity;
+
+	if (LatencyProbe && Value != 0.0f)
+	{
+		LatencyProbe->MarkInput();
+	}
 }
 
 void AGliderPawn::RunAutopilot(const FVector& FlyTarget, float& OutYaw, float& OutPitch, float& OutRoll)
 {
+	const UGliderConfig* GliderConfig = GetConfig();
+	const FGliderTuning& Tuning = GliderConfig->GetTuning();
+
 	const FTransform& ActorTransform = GetActorTransform();
-	FVector LocalFlyTarget = ActorTransform.InverseTransformPosition(FlyTarget).GetSafeNormal() * TurnAngleSensitivity;
+	FVector LocalFlyTarget = ActorTransform.InverseTransformPosition(FlyTarget).GetSafeNormal() * Tuning.TurnAngleSensitivity;
 
 	// Pitch (Z), Yaw (Y), Roll (X)
 	// Base autopilot control signals (full responsiveness)
@@ -321,16 +430,11 @@ void AGliderPawn::RunAutopilot(const FVector& FlyTarget, float& OutYaw, float& O
 	FVector ToTarget = (FlyTarget - GetActorLocation()).GetSafeNormal();
 	float AngleOffTarget = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(GetActorForwardVector(), ToTarget)));
 
-	float BlendFactor = FMath::Clamp(AngleOffTarget / AggressiveTurnAngle, 0.0f, 1.0f);
+	float BlendFactor = FMath::Clamp(AngleOffTarget / Tuning.AggressiveTurnAngle, 0.0f, 1.0f);
 	float BaseRoll = -FMath::Lerp(WingsLevelRoll, AggressiveRoll, BlendFactor);
 
-	// Calculate responsiveness factor [0..1] based on ForwardSpeed
-	// Normalize AirControl between MinimumAirControl and MaximumAirControl to [0..1]
-	float Responsiveness = FMath::GetMappedRangeValueClamped(
-		FVector2D(MinimumAirControl, MaximumAirControl),
-		FVector2D(0.1f, 1.0f),
-		AirControl
-	);
+	// Calculate responsiveness factor [0.1..1] based on AirControl
+	float Responsiveness = GliderConfig->GetResponsiveness(AirControl);
 
 	// Normal autopilot control with responsiveness scaling
 	OutPitch = BasePitch * Responsiveness;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Engine/EngineBaseTypes.h"
+#include "GliderSoakCommandlet.generated.h"
+
+// Writes time of its execution, used to bracket the physics step
+USTRUCT()
+struct FGliderSoakMarkerTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	double* OutSeconds = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGliderSoakMarkerTickFunction> : public TStructOpsTypeTraitsBase2<FGliderSoakMarkerTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+// Headless scaling test of gliders
+// Loads a level, spawns gliders in steps and flies them toward scripted targets,
+// every step records game thread time, physics time, memory per aircraft and garbage collection cost to a csv file.
+//
+// UnrealEditor-Cmd ProjectFlyReborn -run=GliderSoak -nullrhi [-Map=/Game/Maps/TestLevel] [-Steps=10,100,1000,5000]
+//     [-Glider=/Game/Pawn/BP_GliderPawn.BP_GliderPawn_C] [-WarmupFrames=60] [-MeasureFrames=300] [-Output=<csv path>]
+UCLASS()
+class PROJECTFLYREBORN_API UGliderSoakCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGliderSoakCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FStepResult
+	{
+		int32 AircraftCount = 0;
+		double GameThreadMs = 0.0;
+		double GameThreadP95Ms = 0.0;
+		double PhysicsMs = 0.0;
+		double MemoryMB = 0.0;
+		double MemoryPerAircraftKB = 0.0;
+		double GarbageCollectionMs = 0.0;
+	};
+
+	UWorld* CreateGameWorld(const FString& MapName);
+	void DestroyGameWorld(UWorld* World);
+
+	void SpawnGliders(UWorld* World, TSubclassOf<class AGliderPawn> GliderClass, int32 Count);
+	void UpdateFlyTargets(float Time);
+	void TickWorld(UWorld* World, float DeltaTime, double& OutGameThreadMs, double& OutPhysicsMs);
+
+	bool WriteCsv(const FString& FilePath, const TArray<FStepResult>& Results) const;
+
+	FGliderSoakMarkerTickFunction PhysicsStartTickFunction;
+	FGliderSoakMarkerTickFunction PhysicsEndTickFunction;
+
+	double PhysicsStartSeconds = 0.0;
+	double PhysicsEndSeconds = 0.0;
+
+	// Game mode is created through the game instance, without it actors never receive BeginPlay
+	UPROPERTY()
+	class UGameInstance* GameInstance = nullptr;
+
+	UPROPERTY()
+	TArray<class AGliderPawn*> Gliders;
+
+	FVector FlightCenter = FVector::ZeroVector;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InputLatencyProbeSubsystem.generated.h"
+
+class UInputLatencyProbeSubsystem;
+
+// Stamps samples once physics of the frame has finished
+USTRUCT()
+struct FLatencyProbePhysicsTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UInputLatencyProbeSubsystem* Probe = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FLatencyProbePhysicsTickFunction> : public TStructOpsTypeTraitsBase2<FLatencyProbePhysicsTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+// Rolling latency samples of one pipeline stage (milliseconds)
+struct FLatencyHistogram
+{
+	void Add(float Milliseconds);
+	void Reset();
+
+	// Percentile [0..1] of the stored samples
+	float GetPercentile(float Percentile) const;
+
+	// Text histogram of the stored samples with power of two millisecond buckets
+	FString ToString() const;
+
+	int32 Num() const { return Samples.Num(); }
+
+	static constexpr int32 MaxSamples = 1024;
+	static constexpr int32 BucketCount = 8;
+
+	TArray<float> Samples;
+	int32 NextSample = 0;
+};
+
+// Mouse aim latency measurement, enabled with fly.LatencyProbe 1
+// A mouse event is stamped when it reaches Turn/LookUp, then carried through torque application in the pawn tick,
+// end of the physics step and present of the rendered frame. Percentiles of each stage are logged and shown on screen.
+UCLASS()
+class PROJECTFLYREBORN_API UInputLatencyProbeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static bool IsEnabled();
+
+	// Mouse event reached the pawn, only the oldest not yet applied event is tracked
+	void MarkInput();
+
+	// Torque from tracked input was applied to the physics body
+	void MarkInputApplied();
+
+	// Physics step of the frame finished
+	void MarkPhysicsDone();
+
+private:
+	struct FLatencySample
+	{
+		uint64 InputCycles = 0;
+		uint64 AppliedCycles = 0;
+		uint64 PhysicsCycles = 0;
+		uint64 PresentCycles = 0;
+	};
+
+	// State shared with the render thread, outlives the subsystem while render commands are in flight
+	struct FRenderState;
+
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaTime);
+	void ReportHistograms();
+
+	FLatencyProbePhysicsTickFunction PhysicsTickFunction;
+
+	uint64 PendingInputCycles = 0;
+	TArray<FLatencySample> AwaitingPhysics;
+	TArray<FLatencySample> AwaitingFrame;
+
+	TSharedPtr<FRenderState, ESPMode::ThreadSafe> RenderState;
+	bool bHasPresentCallback = false;
+
+	FDelegateHandle PostActorTickHandle;
+	FDelegateHandle PresentHandle;
+
+	FLatencyHistogram InputToApply;
+	FLatencyHistogram ApplyToPhysics;
+	FLatencyHistogram PhysicsToPresent;
+	FLatencyHistogram InputToPresent;
+	FLatencyHistogram FrameTime;
+
+	double LastReportTime = 0.0;
+};
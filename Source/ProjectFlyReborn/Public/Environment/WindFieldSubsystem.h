@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WindFieldSubsystem.generated.h"
+
+// Baked wind field of all AWindVolume actors in the world
+// Field is stored as a sparse brick map: a coarse index grid pointing into dense bricks of samples,
+// only bricks touched by a volume are allocated. Both allocated bricks and the index grid are capped
+// (fly.WindField.MaxBricks, fly.WindField.MaxIndexBricks), the grid is coarsened until they fit.
+// Sampling is a single index lookup and 8 loads, the data is read-only after baking so it can be queried from any thread.
+UCLASS()
+class PROJECTFLYREBORN_API UWindFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Trilinear interpolated wind velocity (cm/s), zero outside of baked volumes
+	FVector SampleWind(const FVector& WorldLocation) const;
+
+	// Rebakes field from the volumes currently in the world
+	UFUNCTION(BlueprintCallable, Category = "Wind")
+	void RebuildWindField();
+
+	bool HasWindField() const { return Bricks.Num() > 0; }
+
+private:
+	// Cells per brick side
+	static constexpr int32 BrickCells = 8;
+
+	// Samples per brick side, one extra layer so every cell has all 8 corners in its own brick
+	static constexpr int32 BrickSamples = BrickCells + 1;
+	static constexpr int32 SamplesPerBrick = BrickSamples * BrickSamples * BrickSamples;
+
+	void Reset();
+
+	FVector Origin = FVector::ZeroVector;
+	double CellSize = 0.0;
+	double InvCellSize = 0.0;
+
+	// Size of the field in cells
+	FIntVector CellCount = FIntVector::ZeroValue;
+
+	// Size of the index grid in bricks
+	FIntVector BrickCount = FIntVector::ZeroValue;
+
+	// Index into Bricks (in SamplesPerBrick units) or INDEX_NONE for empty space
+	TArray<int32> BrickIndices;
+
+	// Dense samples of all allocated bricks
+	TArray<FVector3f> Bricks;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WindVolume.generated.h"
+
+// Designer placed box of wind and/or thermal updraft
+// Volumes are not sampled at runtime, they are baked into UWindFieldSubsystem on world begin play
+UCLASS()
+class PROJECTFLYREBORN_API AWindVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AWindVolume();
+
+	// Analytic wind velocity (cm/s) at world location, used only while baking
+	FVector EvaluateWind(const FVector& WorldLocation) const;
+
+	// World space bounds of the volume
+	FBox GetWindBounds() const;
+
+	// Volume with zero extent on any axis has no inside and can not be evaluated
+	bool HasValidExtent() const;
+
+private:
+	UPROPERTY(VisibleAnywhere)
+	class UBoxComponent* BoxComponent;
+
+	// Constant wind inside the volume (world space, cm/s)
+	UPROPERTY(EditAnywhere, Category = "Wind")
+	FVector WindVelocity = FVector::ZeroVector;
+
+	// Part of the box extent [0..1] used to fade wind in at the volume edges
+	UPROPERTY(EditAnywhere, Category = "Wind", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float EdgeFalloff = 0.2f;
+
+	UPROPERTY(EditAnywhere, Category = "Wind - Thermal")
+	bool bIsThermal = false;
+
+	// Vertical speed at the thermal core (cm/s)
+	UPROPERTY(EditAnywhere, Category = "Wind - Thermal", meta = (ClampMin = 0.0f, EditCondition = "bIsThermal"))
+	float ThermalUpdraft = 1500.0f;
+
+	// Part of the horizontal radius [0..1] where updraft is at full strength
+	UPROPERTY(EditAnywhere, Category = "Wind - Thermal", meta = (ClampMin = 0.0f, ClampMax = 1.0f, EditCondition = "bIsThermal"))
+	float ThermalCoreRadius = 0.3f;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "FlightAvoidanceSubsystem.generated.h"
+
+// Look-ahead terrain and obstacle probing for all registered aircraft
+// Each frame a bounded number of async sweeps is issued round-robin over aircraft,
+// results are read back on the next frame and turned into an avoidance vector per aircraft.
+// Trace cost per frame does not depend on how many aircraft are registered.
+UCLASS()
+class PROJECTFLYREBORN_API UFlightAvoidanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterAircraft(APawn* Aircraft);
+	void UnregisterAircraft(APawn* Aircraft);
+
+	int32 GetAircraftCount() const { return Probes.Num(); }
+
+	// Direction away from the obstacle ahead scaled by urgency [0..1], zero when path is clear.
+	// Urgency fades with the age of the last probe result, over at least the time until the aircraft is probed again
+	FVector GetAvoidance(const APawn* Aircraft) const;
+
+private:
+	struct FAircraftProbe
+	{
+		TWeakObjectPtr<APawn> Aircraft;
+		TObjectKey<APawn> AircraftKey;
+		FTraceHandle PendingTrace;
+		FVector Avoidance = FVector::ZeroVector;
+
+		// World time the avoidance was read back
+		double ResultTime = 0.0;
+
+		// Expected wait (seconds) until this aircraft is probed again, estimated when the trace was issued
+		float RevisitTime = 0.0f;
+	};
+
+	void ReadTraceResults();
+	void IssueTraces(float DeltaTime);
+
+	TArray<FAircraftProbe> Probes;
+	TMap<TObjectKey<APawn>, int32> ProbeIndices;
+
+	// Next probe to get a trace, keeps aircraft fairly served when budget is smaller than aircraft count
+	int32 NextProbe = 0;
+
+	// Smoothed number of traces per second actually issued, lower than MaxTracesPerFrame when time budget runs out
+	float IssuedTraceRate = 0.0f;
+};
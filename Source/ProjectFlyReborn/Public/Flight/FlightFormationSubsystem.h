@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FlightFormationSubsystem.generated.h"
+
+UENUM(BlueprintType)
+enum class EFlightFormationShape : uint8
+{
+	// Followers alternate left and right behind the leader
+	Vee,
+	// Followers line up diagonally behind leader's right wing
+	Echelon,
+	// Followers fly side by side with the leader
+	LineAbreast,
+	// Followers trail one behind another
+	Column
+};
+
+// Formation flight of AI aircraft behind a leader
+// Every formation predicts its leader pose once per frame and computes steering targets of all followers
+// in a single pass, followers receive them through SetDesiredDirection. Gliders also get extra forward
+// acceleration through SetForwardAcceleration to hold the slot distance along the flight path. Large formations spread follower updates over several
+// frames, so cost per frame stays bounded.
+UCLASS()
+class PROJECTFLYREBORN_API UFlightFormationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Returns id of the new formation or INDEX_NONE
+	UFUNCTION(BlueprintCallable, Category = "Formation")
+	int32 CreateFormation(APawn* Leader, EFlightFormationShape Shape = EFlightFormationShape::Vee, float Spacing = 1500.0f);
+
+	UFUNCTION(BlueprintCallable, Category = "Formation")
+	void DestroyFormation(int32 FormationId);
+
+	// Follower takes the next free slot, it has to implement IFlightMouseAimInterface
+	UFUNCTION(BlueprintCallable, Category = "Formation")
+	bool AddFollower(int32 FormationId, APawn* Follower);
+
+	UFUNCTION(BlueprintCallable, Category = "Formation")
+	void RemoveFollower(int32 FormationId, APawn* Follower);
+
+private:
+	struct FFormationFollower
+	{
+		// Steering interface and glider are resolved from the pawn on every update, nothing else is cached
+		TWeakObjectPtr<APawn> Pawn;
+
+		// Slot in leader heading space (X forward, Y right, Z up)
+		FVector SlotOffset = FVector::ZeroVector;
+	};
+
+	struct FFormation
+	{
+		int32 Id = INDEX_NONE;
+		TWeakObjectPtr<APawn> Leader;
+		EFlightFormationShape Shape = EFlightFormationShape::Vee;
+		float Spacing = 0.0f;
+		TArray<FFormationFollower> Followers;
+
+		// Last leader heading with horizontal component, keeps slots stable while the leader dives vertically
+		FVector LastHeading = FVector::ForwardVector;
+
+		// Frame counter used to stagger follower updates of large formations
+		uint32 UpdateFrame = 0;
+	};
+
+	static FVector CalculateSlotOffset(EFlightFormationShape Shape, float Spacing, int32 SlotIndex);
+
+	// Assigns slots in follower order, closing gaps left by removed followers
+	static void ReassignSlots(FFormation& Formation);
+
+	void UpdateFormation(FFormation& Formation, float DeltaTime);
+
+	FFormation* FindFormation(int32 FormationId);
+
+	TArray<FFormation> Formations;
+	int32 NextFormationId = 0;
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GliderConfig.generated.h"
+
+// Tuning values of a glider, kept in a struct so it can be round-tripped through json for hot reload
+USTRUCT(BlueprintType)
+struct PROJECTFLYREBORN_API FGliderTuning
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Turn Control", meta = (ClampMin = 0.0f))
+	FVector TurnTorque = FVector(45.f, 25.f, 45.f);
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Turn Control", meta = (ClampMin = 0.0f))
+	float MouseSensitivity = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Turn Control", meta = (ClampMin = 0.0f))
+	float TurnAngleSensitivity = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Turn Control", meta = (ClampMin = 0.0f))
+	float AggressiveTurnAngle = 10.0f;
+
+	// How strongly obstacle avoidance overrides player aim, 1 means full override at the closest obstacle
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Turn Control", meta = (ClampMin = 0.0f))
+	float AvoidanceStrength = 1.5f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Lift Control", meta = (ClampMin = 0.0f))
+	float LiftCoefficientScalar = 0.004f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Lift Control", meta = (ClampMin = 0.0f))
+	float MaxLiftForce = 20000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
+	float MinimumPlaneSpeed = 3000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
+	float MaximumPlaneSpeed = 20000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
+	float StartPlaneSpeed = 12000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
+	float DiveSpeedIncreaseScalar = 1000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
+	float RiseSpeedDecreaseScalar = 2500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Air Control", meta = (ClampMin = 0.0f))
+	float MinimumAirControl = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Air Control", meta = (ClampMin = 0.0f))
+	float MaximumAirControl = 8.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Gravity Control", meta = (ClampMin = 0.0f))
+	float GravityScalar = 2500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Gravity Control", meta = (ClampMin = 0.0f))
+	float GravityMultiplier = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Dash")
+	float DashSpeedCost = 500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Dash")
+	float DashStrength = 200000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Dash")
+	float DashCooldown = 3.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Halt")
+	float HaltSpeedCost = 500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Halt")
+	float HaltDuration = 0.5f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Halt")
+	float HaltCooldown = 3.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Glider Control - Halt")
+	float HaltSpeedLinearDamping = 2.0f;
+
+	// Applies ClampMin limits of the properties, editor enforces them only in details panel
+	// Returns true if any value was out of range
+	bool ClampToLimits();
+};
+
+// Shared aircraft config, gliders only point to it and never modify it
+// Class default object is used by gliders without assigned config
+UCLASS(BlueprintType)
+class PROJECTFLYREBORN_API UGliderConfig : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UGliderConfig();
+
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	const FGliderTuning& GetTuning() const { return Tuning; }
+
+	// Replaces tuning and recalculates derived values, used by hot reload
+	void ApplyTuning(const FGliderTuning& NewTuning);
+
+	// Air control for forward speed, mapped from [MinimumPlaneSpeed..MaximumPlaneSpeed] to [MinimumAirControl..MaximumAirControl]
+	float GetAirControl(float ForwardSpeed) const
+	{
+		const float Alpha = GetRangeAlpha(ForwardSpeed, Tuning.MinimumPlaneSpeed, Tuning.MaximumPlaneSpeed, InvPlaneSpeedRange);
+		return FMath::Lerp(Tuning.MinimumAirControl, Tuning.MaximumAirControl, Alpha);
+	}
+
+	// Autopilot responsiveness for air control, mapped from [MinimumAirControl..MaximumAirControl] to [0.1..1]
+	float GetResponsiveness(float AirControl) const
+	{
+		const float Alpha = GetRangeAlpha(AirControl, Tuning.MinimumAirControl, Tuning.MaximumAirControl, InvAirControlRange);
+		return FMath::Lerp(0.1f, 1.0f, Alpha);
+	}
+
+private:
+	void UpdateDerivedValues();
+
+	// Same result as FMath::GetMappedRangeValueClamped with a cached reciprocal of the range
+	// Inverted ranges map backwards, empty range steps from 0 to 1 at Max
+	static float GetRangeAlpha(float Value, float Min, float Max, float InvRange)
+	{
+		if (InvRange == 0.0f)
+		{
+			return Value >= Max ? 1.0f : 0.0f;
+		}
+		return FMath::Clamp((Value - Min) * InvRange, 0.0f, 1.0f);
+	}
+
+	UPROPERTY(EditAnywhere, Category = "Glider", meta = (ShowOnlyInnerProperties))
+	FGliderTuning Tuning;
+
+	// Derived values, recalculated whenever tuning changes, zero for an empty range
+	float InvPlaneSpeedRange = 0.0f;
+	float InvAirControlRange = 0.0f;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "GliderConfigReloadSubsystem.generated.h"
+
+// Live tuning of loaded glider configs outside of the editor
+// Watches Saved/GliderTuning/<ConfigName>.json and applies changed files to the matching UGliderConfig,
+// class default object used by gliders without assigned config maps to Default.json.
+// Files can be created from current values with "fly.GliderConfig.Export" console command.
+UCLASS()
+class PROJECTFLYREBORN_API UGliderConfigReloadSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Writes json file with current tuning for every loaded config
+	void ExportLoadedConfigs();
+
+	static FString GetTuningFilePath(const class UGliderConfig* Config);
+
+private:
+	bool PollTuningFiles(float DeltaTime);
+
+	FTSTicker::FDelegateHandle PollTickerHandle;
+
+	// Timestamp of the last applied or exported file per config
+	TMap<TWeakObjectPtr<class UGliderConfig>, FDateTime> AppliedTimestamps;
+};
@@ -22,8 +22,15 @@ public:
 
 	void AffectSpeed(float Speed);
 
+	// Extra forward acceleration (cm/s^2) on top of the ForwardSpeed thrust, held for Duration seconds
+	// Replaces the previous value instead of accumulating, callers recompute it on every update
+	void SetForwardAcceleration(float Acceleration, float Duration);
+
+	const class UGliderConfig* GetConfig() const;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 private:
@@ -39,94 +46,48 @@ private:
 	UPROPERTY(EditAnywhere)
 	class UCameraComponent* Camera;
 
+	// Baked wind and thermals of the current world
+	UPROPERTY()
+	class UWindFieldSubsystem* WindField = nullptr;
+
+	// Look-ahead obstacle probing shared by all aircraft
+	UPROPERTY()
+	class UFlightAvoidanceSubsystem* Avoidance = nullptr;
+
+	// Mouse aim latency measurement, active with fly.LatencyProbe 1
+	UPROPERTY()
+	class UInputLatencyProbeSubsystem* LatencyProbe = nullptr;
+
 	// Input variables
 	float CameraYaw;
 	float CameraPitch;
 
 	FVector DesiredDirection;
 
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Turn Control", meta = (ClampMin = 0.0f))
-	FVector TurnTorque = FVector(45.f, 25.f, 45.f);
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Turn Control", meta = (ClampMin = 0.0f))
-	float MouseSensitivity = 1.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Turn Control", meta = (ClampMin = 0.0f))
-	float TurnAngleSensitivity = 1.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Turn Control", meta = (ClampMin = 0.0f))
-	float AggressiveTurnAngle = 10.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Lift Control", meta = (ClampMin = 0.0f))
-	float LiftCoefficientScalar = 0.004f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Lift Control", meta = (ClampMin = 0.0f))
-	float MaxLiftForce = 20000.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
-	float MinimumPlaneSpeed = 3000.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
-	float MaximumPlaneSpeed = 20000.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
-	float StartPlaneSpeed = 12000.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
-	float DiveSpeedIncreaseScalar = 1000.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Speed Control", meta = (ClampMin = 0.0f))
-	float RiseSpeedDecreaseScalar = 2500.0f;
+	// Shared tuning of the glider, default config is used when not set
+	UPROPERTY(EditAnywhere, Category = "Glider Control")
+	const class UGliderConfig* Config = nullptr;
 
 	float AirControl = 0.0f;
 
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Air Control", meta = (ClampMin = 0.0f))
-	float MinimumAirControl = 1.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Air Control", meta = (ClampMin = 0.0f))
-	float MaximumAirControl = 8.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Gravity Control", meta = (ClampMin = 0.0f))
-	float GravityScalar = 2500.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Gravity Control", meta = (ClampMin = 0.0f))
-	float GravityMultiplier = 1.0f; 
-
 	// Forward speed of the plane
 	// This is the main variable, which defines speed of the plane 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	float ForwardSpeed = 0.0f;
 
+	// Set by SetForwardAcceleration, ignored after end time
+	float ForwardAcceleration = 0.0f;
+	double ForwardAccelerationEndTime = 0.0;
+
 	// Dash Settings
 	FTimerHandle DashStopTimer;
 	FTimerHandle DashCooldownTimer;
 
 	bool bCanDash = true;
 
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Dash")
-	float DashSpeedCost = 500.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Dash")
-	float DashStrength = 200000.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Dash")
-	float DashCooldown = 3.0f;
-
 	// Halt Settings
 	FTimerHandle HaltTimer;
 
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Halt")
-	float HaltSpeedCost = 500.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Halt")
-	float HaltDuration = 0.5f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Halt")
-	float HaltCooldown = 3.0f;
-
-	UPROPERTY(EditAnywhere, Category = "Glider Control - Halt")
-	float HaltSpeedLinearDamping = 2.0f;
-
 	float LinearDampingBeforeHaltBackup = 0.0f;
 
 	bool bCanHalt = true;